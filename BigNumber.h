@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 #include <stdexcept>
@@ -11,776 +12,5030 @@
 #include <sstream>
 #include <ctime>
 #include <random>
-
-#define SUPPORT_IFSTREAM 0
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <numeric>
+#include <tuple>
+#include <span>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <compare>
+#include <iterator>
+#include <ranges>
+#include <unordered_set>
+
+#define SUPPORT_IFSTREAM 1
 #define SUPPORT_MORE_OPS 1
 #define SUPPORT_EVAL 0
+#ifndef SUPPORT_STATS
+#define SUPPORT_STATS 0
+#endif
+#ifndef SUPPORT_ASYNC
+#define SUPPORT_ASYNC 1
+#endif
+#if __has_include(<sys/mman.h>)
+#define SUPPORT_FILES 1
+#else
+#define SUPPORT_FILES 0
+#endif
+
+#if SUPPORT_ASYNC == 1
+#include <future>
+#include <stop_token>
+#include <condition_variable>
+#include <deque>
+#endif
+
+#if SUPPORT_FILES == 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #define MODULO 1'000'000'000
 #define DIGITS 9
 
+// 128-bit medzivysledky (GCC)
+__extension__ typedef unsigned __int128 WideLimb;
 
-class BigInteger
+// kernel thresholds (in limbs); BigNumberTuning.h is generated by bignumber_tune for the host CPU
+#if __has_include("BigNumberTuning.h")
+#include "BigNumberTuning.h"
+#endif
+
+#ifndef BIGNUMBER_KARATSUBA_THRESHOLD
+#define BIGNUMBER_KARATSUBA_THRESHOLD 24
+#endif
+
+#ifndef BIGNUMBER_BURNIKEL_ZIEGLER_THRESHOLD
+#define BIGNUMBER_BURNIKEL_ZIEGLER_THRESHOLD 96
+#endif
+
+#ifndef BIGNUMBER_MONTGOMERY_THRESHOLD
+#define BIGNUMBER_MONTGOMERY_THRESHOLD 256
+#endif
+
+
+// instrumentation: compile with SUPPORT_STATS 1 (or -DSUPPORT_STATS=1) to count calls, operand sizes, allocations and time per operation
+#if SUPPORT_STATS == 1
+#define STATS_BUCKETS 32
+
+enum class BigOperation { Add, Subtract, Multiply, Divide, Modulo, Pow, ModPow, PrimeTest, IntegerSqrt, Simplify, Count };
+
+constexpr const char* stats_operation_name(BigOperation operation) {
+    constexpr std::array<const char*, static_cast<size_t>(BigOperation::Count)> names = {
+        "add", "subtract", "multiply", "divide", "modulo", "pow", "modpow", "prime_test", "isqrt", "simplify"
+    };
+    return names[static_cast<size_t>(operation)];
+}
+
+struct BigStatsEvent
 {
-public:
-    // constructors
-    BigInteger()
-        : numbers{0}
-        , negative(false)
-        , zero(true)
-    {}
-    
-    BigInteger(int64_t n)
-        : numbers()
-        , negative(false)
-        , zero(false)
-    {   
-        if (n == 0) {
-            numbers.push_back(0);
-            this->zero = true;
-            return;
+    BigOperation operation;
+    size_t limbs;           // operand size (larger operand)
+    uint64_t allocations;   // limb buffers allocated by this call, nested calls excluded
+    uint64_t bytes;
+    uint64_t nanoseconds;   // 0 when timing is off
+};
+
+using BigStatsCallback = std::function<void(const BigStatsEvent&)>;
+
+struct BigOperationStats
+{
+    uint64_t calls = 0;
+    uint64_t limbs = 0;
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    uint64_t nanoseconds = 0;
+    std::array<uint64_t, STATS_BUCKETS> sizes{};  // sizes[i]: calls with 2^(i-1) < limbs <= 2^i
+};
+
+struct BigStatsSnapshot
+{
+    const BigOperationStats& operator[](BigOperation operation) const {
+        return this->operations[static_cast<size_t>(operation)];
+    }
+
+    std::string report() const {  // csv: operation,calls,limbs,allocations,bytes,ns,sizes ("limbs:calls" pairs)
+        std::ostringstream out;
+        out << "operation,calls,limbs,allocations,bytes,ns,sizes\n";
+        for (size_t i = 0; i < this->operations.size(); i++) {
+            const BigOperationStats& stats = this->operations[i];
+            if (stats.calls == 0) { continue; }
+            out << stats_operation_name(static_cast<BigOperation>(i)) << ',' << stats.calls << ',' << stats.limbs << ',' << stats.allocations << ',' << stats.bytes << ',' << stats.nanoseconds << ',';
+            bool first = true;
+            for (size_t bucket = 0; bucket < STATS_BUCKETS; bucket++) {
+                if (stats.sizes[bucket] == 0) { continue; }
+                out << (first ? "" : " ") << (static_cast<uint64_t>(1) << bucket) << ':' << stats.sizes[bucket];
+                first = false;
+            }
+            out << '\n';
         }
-        // Ulozenie zaporneho znamienka
-        if (n < 0) {
-            this->negative = true;
-            n = -n;
+        return out.str();
+    }
+
+    std::array<BigOperationStats, static_cast<size_t>(BigOperation::Count)> operations{};
+};
+
+struct StatsCounters
+{
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> limbs;
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> nanoseconds;
+    std::array<std::atomic<uint64_t>, STATS_BUCKETS> sizes;
+};
+
+struct StatsState
+{
+    std::array<StatsCounters, static_cast<size_t>(BigOperation::Count)> counters{};
+    std::atomic<bool> timing{false};
+    std::atomic<bool> has_callback{false};
+    std::mutex callback_lock;
+    std::shared_ptr<const BigStatsCallback> callback;  // replaced, never modified; the lock guards only the pointer
+};
+
+inline StatsState& Stats() {
+    static StatsState state;
+    return state;
+}
+
+class StatsScope
+{
+public:
+    constexpr StatsScope(BigOperation operation, size_t limbs) : operation(operation), limbs(limbs) {
+        if (!std::is_constant_evaluated()) {
+            this->begin();
         }
-        // Rýchle vybavenie čísla pod limitom
-        if (n < MODULO) {
-            numbers.push_back(n);
-            return;
+    }
+
+    constexpr ~StatsScope() {
+        if (!std::is_constant_evaluated()) {
+            this->end();
         }
-        // Ak číslo presahuje limit MODULO
-        while (n != 0) {
-            numbers.push_back(n % MODULO);
-            n /= MODULO;
+    }
+
+    StatsScope(const StatsScope&) = delete;
+    StatsScope& operator=(const StatsScope&) = delete;
+
+    static StatsScope*& current() {
+        thread_local StatsScope* scope = nullptr;
+        return scope;
+    }
+
+    static bool& in_callback() {  // counted calls made by the callback itself do not call it again
+        thread_local bool active = false;
+        return active;
+    }
+
+    void allocation(size_t bytes) {
+        this->allocations++;
+        this->bytes += bytes;
+    }
+
+private:
+    void begin() {
+        this->parent = current();
+        current() = this;
+        StatsState& state = Stats();
+        if (state.timing.load(std::memory_order_relaxed) || state.has_callback.load(std::memory_order_relaxed)) {
+            this->start = std::chrono::steady_clock::now();
+            this->timed = true;
         }
     }
-    
-    explicit BigInteger(const std::string& str)
-        : numbers()
-        , negative(false)
-        , zero(false)
-    {
-        // Zachytenie prazdneho stringu
-        if (str.empty()) {
-            throw std::runtime_error("Empty BigInteger!");
+
+    void end() {
+        current() = this->parent;
+        uint64_t elapsed = 0;
+        if (this->timed) {
+            elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start).count();
         }
-        // Ak sa maju overit iba ' ', tak staci iba: str.front/back() == ' '
-        if (std::isspace(str.front()) || std::isspace(str.back())) {
-            throw std::runtime_error("White space(s) in BigInteger!");
+
+        StatsState& state = Stats();
+        StatsCounters& counters = state.counters[static_cast<size_t>(this->operation)];
+        counters.calls.fetch_add(1, std::memory_order_relaxed);
+        counters.limbs.fetch_add(this->limbs, std::memory_order_relaxed);
+        counters.allocations.fetch_add(this->allocations, std::memory_order_relaxed);
+        counters.bytes.fetch_add(this->bytes, std::memory_order_relaxed);
+        counters.nanoseconds.fetch_add(elapsed, std::memory_order_relaxed);
+        counters.sizes[std::min<size_t>(std::bit_width(this->limbs > 0 ? this->limbs - 1 : 0), STATS_BUCKETS - 1)].fetch_add(1, std::memory_order_relaxed);
+
+        if (state.has_callback.load(std::memory_order_relaxed) && !in_callback()) {
+            // Kopia pod zamkom, volanie bez neho: callback moze sam pocitat a ine vlakna necakaju
+            std::shared_ptr<const BigStatsCallback> callback;
+            {
+                std::lock_guard<std::mutex> lock(state.callback_lock);
+                callback = state.callback;
+            }
+            if (callback) {
+                struct Reentry
+                {
+                    Reentry() { in_callback() = true; }
+                    ~Reentry() { in_callback() = false; }
+                } reentry;
+                (*callback)(BigStatsEvent{this->operation, this->limbs, this->allocations, this->bytes, elapsed});
+            }
         }
+    }
 
-        uint64_t position = 0;
-        bool negative = false;
-        
-        // Overenie znaku +/-
-        if (str[0] == '+') {
-            position = 1;
+    BigOperation operation;
+    size_t limbs;
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    std::chrono::steady_clock::time_point start{};
+    bool timed = false;
+    StatsScope* parent = nullptr;
+};
+
+constexpr void StatsAllocation(size_t limbs) {  // limb buffer allocated inside the current operation
+    if (!std::is_constant_evaluated()) {
+        if (StatsScope* scope = StatsScope::current()) {
+            scope->allocation(limbs * sizeof(uint64_t));
         }
-        else if (str[0] == '-') {
-            position = 1;
-            negative = true;
+    }
+}
+
+inline BigStatsSnapshot stats_snapshot() {
+    BigStatsSnapshot snapshot;
+    StatsState& state = Stats();
+    for (size_t i = 0; i < snapshot.operations.size(); i++) {
+        const StatsCounters& counters = state.counters[i];
+        BigOperationStats& stats = snapshot.operations[i];
+        stats.calls = counters.calls.load(std::memory_order_relaxed);
+        stats.limbs = counters.limbs.load(std::memory_order_relaxed);
+        stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+        stats.bytes = counters.bytes.load(std::memory_order_relaxed);
+        stats.nanoseconds = counters.nanoseconds.load(std::memory_order_relaxed);
+        for (size_t bucket = 0; bucket < STATS_BUCKETS; bucket++) {
+            stats.sizes[bucket] = counters.sizes[bucket].load(std::memory_order_relaxed);
         }
+    }
+    return snapshot;
+}
 
-        // Ak string ma iba jeden znak (znamienko)
-        if (position == str.size()) {
-            throw std::runtime_error("No digit(s) in BigInteger!");
+inline void stats_reset() {
+    for (StatsCounters& counters : Stats().counters) {
+        counters.calls.store(0, std::memory_order_relaxed);
+        counters.limbs.store(0, std::memory_order_relaxed);
+        counters.allocations.store(0, std::memory_order_relaxed);
+        counters.bytes.store(0, std::memory_order_relaxed);
+        counters.nanoseconds.store(0, std::memory_order_relaxed);
+        for (std::atomic<uint64_t>& bucket : counters.sizes) {
+            bucket.store(0, std::memory_order_relaxed);
         }
-        // Overenie, ze v stringu su iba cifry
-        for (size_t i = position; i < str.size(); i++) {
-            if (!isdigit(str[i])) {
-                throw std::runtime_error("Only digit(s) allowed in BigInteger!");
-            }
+    }
+}
+
+inline void stats_set_timing(bool enabled) {  // steady_clock around every counted call
+    Stats().timing.store(enabled, std::memory_order_relaxed);
+}
+
+inline void stats_set_callback(BigStatsCallback callback) {  // called after every counted call; empty function removes it
+    StatsState& state = Stats();
+    std::lock_guard<std::mutex> lock(state.callback_lock);
+    state.has_callback.store(static_cast<bool>(callback), std::memory_order_relaxed);
+    state.callback = callback ? std::make_shared<const BigStatsCallback>(std::move(callback)) : nullptr;
+}
+
+#define STATS_SCOPE(operation, limbs) StatsScope stats_scope(operation, limbs)
+#define STATS_ALLOCATION(limbs) StatsAllocation(limbs)
+#else
+#define STATS_SCOPE(operation, limbs)
+#define STATS_ALLOCATION(limbs)
+#endif
+
+// cancellation: async operations install their std::stop_token for the worker thread, kernels poll it every CANCEL_BLOCK_LIMBS rows
+#if SUPPORT_ASYNC == 1
+#define CANCEL_BLOCK_LIMBS 64
+
+class BigCancelled : public std::runtime_error
+{
+public:
+    BigCancelled()
+        : std::runtime_error("Operation cancelled!")
+    {}
+};
+
+inline const std::stop_token*& CancelToken() {  // token polled on this thread, nullptr outside of cancellable work
+    thread_local const std::stop_token* token = nullptr;
+    return token;
+}
+
+constexpr void PollCancel() {  // throws BigCancelled once stop was requested
+    if (!std::is_constant_evaluated()) {
+        const std::stop_token* token = CancelToken();
+        if (token != nullptr && token->stop_requested()) {
+            throw BigCancelled();
         }
+    }
+}
 
-        // Hladanie prveho nenuloveho znaku
-        size_t non_zero_position = str.find_first_not_of('0', position);
+constexpr void CancelPoint(size_t row) {  // polls on the first row of every block
+    if (row % CANCEL_BLOCK_LIMBS == 0) {
+        PollCancel();
+    }
+}
 
-        // Ak same 0 v stringu
-        if (non_zero_position == std::string::npos) {
-            this->numbers.push_back(0);
-            this->zero = true;
-            return;
+class BigCancelScope  // operations on this thread honor 'token' until the scope ends; scopes nest
+{
+public:
+    explicit BigCancelScope(const std::stop_token& token)
+        : token(token)
+        , previous(CancelToken())
+    {
+        CancelToken() = &this->token;
+    }
+
+    BigCancelScope(const BigCancelScope&) = delete;
+    BigCancelScope& operator=(const BigCancelScope&) = delete;
+
+    ~BigCancelScope() {
+        CancelToken() = this->previous;
+    }
+
+private:
+    std::stop_token token;
+    const std::stop_token* previous;
+};
+
+#define CANCEL_POINT(row) CancelPoint(static_cast<size_t>(row))
+#else
+#define CANCEL_POINT(row)
+#endif
+
+
+// limb kernels (base MODULO, little-endian)
+constexpr void TrimLimbs(std::vector<uint64_t>& limbs) {
+    // Odstranenie zbytocnych 0 z konca vektora; 0 zostava ako {0}
+    while (limbs.size() > 1 && limbs.back() == 0) {
+        limbs.pop_back();
+    }
+    if (limbs.empty()) {
+        limbs.push_back(0);
+    }
+}
+
+template <class Lhs, class Rhs>
+constexpr int CompareLimbs(const Lhs& lhs, const Rhs& rhs) {  // both trimmed; std::vector<uint64_t> or BigIntegerView
+    if (lhs.size() != rhs.size()) {
+        return (lhs.size() < rhs.size()) ? -1 : 1;
+    }
+    for (size_t i = lhs.size(); i-- > 0;) {
+        if (lhs[i] != rhs[i]) {
+            return (lhs[i] < rhs[i]) ? -1 : 1;
         }
-        std::string clean_string = str.substr(non_zero_position);
+    }
+    return 0;
+}
 
-        std::string part;
-        // Rozdelenie stringu od konca, po castiach, do vektora
-        for (int64_t i = clean_string.size(); i > 0; i -= DIGITS) {
-            if (i <= DIGITS) {
-                part = clean_string.substr(0, i);
-            }
-            else {
-                part = clean_string.substr(i - DIGITS, DIGITS);
-            }
-            this->numbers.push_back(std::stoull(part));
+constexpr std::vector<uint64_t> SliceLimbs(const std::vector<uint64_t>& limbs, size_t from, size_t count) {  // (limbs / MODULO^from) % MODULO^count
+    std::vector<uint64_t> slice;
+    STATS_ALLOCATION(count);
+    for (size_t i = from; i < std::min(limbs.size(), from + count); i++) {
+        slice.push_back(limbs[i]);
+    }
+    TrimLimbs(slice);
+    return slice;
+}
+
+constexpr std::vector<uint64_t> ShiftLimbs(const std::vector<uint64_t>& limbs, size_t count) {  // limbs * MODULO^count
+    if (limbs.size() == 1 && limbs[0] == 0) {
+        return limbs;
+    }
+    std::vector<uint64_t> shifted(count, 0);
+    STATS_ALLOCATION(count + limbs.size());
+    shifted.insert(shifted.end(), limbs.begin(), limbs.end());
+    return shifted;
+}
+
+template <class Source>
+constexpr void AddLimbsAt(uint64_t* target, size_t size, size_t offset, Source source, size_t count) {  // target += source * MODULO^offset
+    uint64_t carrying = 0;
+    for (size_t i = 0; (i < count || carrying > 0) && (offset + i) < size; i++) {
+        carrying += target[offset + i];
+        if (i < count) {
+            carrying += source[i];
         }
+        target[offset + i] = carrying % MODULO;
+        carrying /= MODULO;
+    }
+}
 
-        // Priradenie znamienka
-        this->negative = negative;
-    };
-    
-    // move
-    BigInteger(BigInteger&& other) noexcept
-        : numbers(std::move(other.numbers))
-        , negative(other.negative)
-        , zero(other.zero)
-    {
-        other.negative = false;
-        other.zero = false;
+constexpr void SubtractLimbsAt(uint64_t* target, size_t size, const uint64_t* source, size_t count) {  // target -= source, target >= source
+    int64_t taking = 0;
+    for (size_t i = 0; (i < count || taking > 0) && i < size; i++) {
+        int64_t difference = static_cast<int64_t>(target[i]) - taking;
+        if (i < count) {
+            difference -= static_cast<int64_t>(source[i]);
+        }
+        taking = (difference < 0);
+        target[i] = (difference < 0) ? (difference + MODULO) : difference;
     }
+}
 
-    BigInteger& operator=(BigInteger&& other) noexcept {
-        // Ide o ten isty objekt
-        if (this == &other) {
-            return *this;
+constexpr std::vector<uint64_t> AddLimbs(const std::vector<uint64_t>& lhs, const std::vector<uint64_t>& rhs) {
+    std::vector<uint64_t> sum(std::max(lhs.size(), rhs.size()) + 1, 0);
+    STATS_ALLOCATION(sum.size());
+    std::copy(lhs.begin(), lhs.end(), sum.begin());
+    AddLimbsAt(sum.data(), sum.size(), 0, rhs.data(), rhs.size());
+    TrimLimbs(sum);
+    return sum;
+}
+
+constexpr std::vector<uint64_t> SubtractLimbs(const std::vector<uint64_t>& lhs, const std::vector<uint64_t>& rhs) {  // lhs >= rhs
+    std::vector<uint64_t> difference(lhs);
+    STATS_ALLOCATION(difference.size());
+    SubtractLimbsAt(difference.data(), difference.size(), rhs.data(), rhs.size());
+    TrimLimbs(difference);
+    return difference;
+}
+
+template <class Limbs>
+constexpr std::vector<uint64_t> MultiplySmallLimbs(const Limbs& limbs, uint64_t factor) {  // factor < MODULO
+    std::vector<uint64_t> product(limbs.size() + 1, 0);
+    STATS_ALLOCATION(product.size());
+    uint64_t carrying = 0;
+    for (size_t i = 0; i < limbs.size(); i++) {
+        carrying += limbs[i] * factor;
+        product[i] = carrying % MODULO;
+        carrying /= MODULO;
+    }
+    product[limbs.size()] = carrying;
+    TrimLimbs(product);
+    return product;
+}
+
+constexpr uint64_t DivideSmallLimbs(std::vector<uint64_t>& limbs, uint64_t divisor) {  // in place, returns remainder; divisor < MODULO
+    uint64_t rest = 0;
+    for (size_t i = limbs.size(); i-- > 0;) {
+        uint64_t current = (rest * MODULO) + limbs[i];
+        limbs[i] = current / divisor;
+        rest = current % divisor;
+    }
+    TrimLimbs(limbs);
+    return rest;
+}
+
+template <class A, class B>
+constexpr void MultiplySchoolbook(A a, size_t a_size, B b, size_t b_size, uint64_t* storage) {  // A, B: const uint64_t* or BigIntegerView::LimbIterator  // storage[a_size + b_size] += a*b
+    // Loop, ktory berie kazde cislo z 'a'
+    for (size_t i = 0; i < a_size; i++) {
+        CANCEL_POINT(i);
+        // Nasobenie 0-lou nema ziadny efekt na vysledok
+        if (a[i] == 0) { continue; }
+
+        uint64_t carrying = 0;
+        // Loop, ktory nasobi kazde 'b' s aktualnym 'a'
+        for (size_t j = 0; j < b_size; j++) {
+            uint64_t total = storage[i+j] + carrying + (a[i] * b[j]);
+            storage[i+j] = total % MODULO;
+            carrying = total / MODULO;
         }
-        this->numbers = std::move(other.numbers);
-        this->negative = other.negative;
-        this->zero = other.zero;
+        // Prenos do vyssich limbov
+        for (size_t j = i + b_size; carrying > 0; j++) {
+            uint64_t total = storage[j] + carrying;
+            storage[j] = total % MODULO;
+            carrying = total / MODULO;
+        }
+    }
+}
 
-        other.negative = false;
-        other.zero = false;
-        
-        return *this;
-    };
+template <class A, class B>
+constexpr void MultiplyKaratsuba(A a, size_t a_size, B b, size_t b_size, uint64_t* storage, size_t threshold) {  // storage[a_size + b_size] (zeroed) = a*b
+    // Dlhsi operand je vzdy 'a'
+    if (a_size < b_size) {
+        MultiplyKaratsuba(b, b_size, a, a_size, storage, threshold);
+        return;
+    }
+    // Male operandy; Skolske nasobenie je rychlejsie (pod 4 limby by sa rekurzia nezmensovala)
+    if (b_size < std::max<size_t>(threshold, 4)) {
+        MultiplySchoolbook(a, a_size, b, b_size, storage);
+        return;
+    }
 
-    // copy
-    BigInteger(const BigInteger& other)
-        : numbers(other.numbers)
-        , negative(other.negative)
-        , zero(other.zero)
-    {}
-    
-    BigInteger& operator=(const BigInteger& rhs) {
-        // Ide o ten isty objekt
-        if (this == &rhs) {
-            return *this;
+    const size_t half = (a_size + 1) / 2;
+    // Nevyvazene operandy: a = a0 + a1*B^half, 'b' nema hornu polovicu
+    if (b_size <= half) {
+        MultiplyKaratsuba(a, half, b, b_size, storage, threshold);
+        std::vector<uint64_t> high((a_size - half) + b_size, 0);
+        STATS_ALLOCATION(high.size());
+        MultiplyKaratsuba(a + half, a_size - half, b, b_size, high.data(), threshold);
+        AddLimbsAt(storage, a_size + b_size, half, high.data(), high.size());
+        return;
+    }
+
+    // z0 = a0*b0 do storage[0, 2*half), z2 = a1*b1 do storage[2*half, ...)
+    MultiplyKaratsuba(a, half, b, half, storage, threshold);
+    MultiplyKaratsuba(a + half, a_size - half, b + half, b_size - half, storage + (2 * half), threshold);
+
+    // z1 = (a0+a1)*(b0+b1) - z0 - z2
+    std::vector<uint64_t> sum_a(half + 1, 0);
+    std::vector<uint64_t> sum_b(half + 1, 0);
+    STATS_ALLOCATION(half + 1);
+    STATS_ALLOCATION(half + 1);
+    std::copy(a, a + half, sum_a.begin());
+    std::copy(b, b + half, sum_b.begin());
+    AddLimbsAt(sum_a.data(), sum_a.size(), 0, a + half, a_size - half);
+    AddLimbsAt(sum_b.data(), sum_b.size(), 0, b + half, b_size - half);
+
+    std::vector<uint64_t> middle(2 * (half + 1), 0);
+    STATS_ALLOCATION(middle.size());
+    MultiplyKaratsuba(sum_a.data(), sum_a.size(), sum_b.data(), sum_b.size(), middle.data(), threshold);
+    SubtractLimbsAt(middle.data(), middle.size(), storage, 2 * half);
+    SubtractLimbsAt(middle.data(), middle.size(), storage + (2 * half), (a_size + b_size) - (2 * half));
+
+    AddLimbsAt(storage, a_size + b_size, half, middle.data(), middle.size());
+}
+
+template <class Lhs, class Rhs>
+constexpr std::vector<uint64_t> MultiplyLimbs(const Lhs& a, const Rhs& b, size_t threshold = BIGNUMBER_KARATSUBA_THRESHOLD) {
+    std::vector<uint64_t> storage(a.size() + b.size(), 0);
+    STATS_ALLOCATION(storage.size());
+    // Vyber algoritmu podla kratsieho operandu
+    if (std::min(a.size(), b.size()) < threshold) {
+        MultiplySchoolbook(a.data(), a.size(), b.data(), b.size(), storage.data());
+    }
+    else {
+        MultiplyKaratsuba(a.data(), a.size(), b.data(), b.size(), storage.data(), threshold);
+    }
+    TrimLimbs(storage);
+    return storage;
+}
+
+constexpr void SquareSchoolbook(const uint64_t* a, size_t size, uint64_t* storage) {  // storage[2 * size] (zeroed) = a*a
+    // Suciny a[i]*a[j] pre i < j sa pocitaju iba raz
+    for (size_t i = 0; i < size; i++) {
+        CANCEL_POINT(i);
+        if (a[i] == 0) { continue; }
+
+        uint64_t carrying = 0;
+        for (size_t j = i + 1; j < size; j++) {
+            uint64_t total = storage[i+j] + carrying + (a[i] * a[j]);
+            storage[i+j] = total % MODULO;
+            carrying = total / MODULO;
+        }
+        for (size_t j = i + size; carrying > 0; j++) {
+            uint64_t total = storage[j] + carrying;
+            storage[j] = total % MODULO;
+            carrying = total / MODULO;
+        }
+    }
+
+    // Zdvojnasobenie a pripocitanie stvorcov a[i]^2 na diagonale
+    uint64_t carrying = 0;
+    for (size_t i = 0; i < size; i++) {
+        uint64_t square = a[i] * a[i];
+        uint64_t total = (2 * storage[2*i]) + (square % MODULO) + carrying;
+        storage[2*i] = total % MODULO;
+        carrying = total / MODULO;
+
+        total = (2 * storage[(2*i) + 1]) + (square / MODULO) + carrying;
+        storage[(2*i) + 1] = total % MODULO;
+        carrying = total / MODULO;
+    }
+}
+
+constexpr void SquareKaratsuba(const uint64_t* a, size_t size, uint64_t* storage, size_t threshold) {  // storage[2 * size] (zeroed) = a*a
+    if (size < std::max<size_t>(threshold, 4)) {
+        SquareSchoolbook(a, size, storage);
+        return;
+    }
+    const size_t half = (size + 1) / 2;
+
+    // z0 = a0^2, z2 = a1^2, z1 = (a0+a1)^2 - z0 - z2
+    SquareKaratsuba(a, half, storage, threshold);
+    SquareKaratsuba(a + half, size - half, storage + (2 * half), threshold);
+
+    std::vector<uint64_t> sum(half + 1, 0);
+    STATS_ALLOCATION(sum.size());
+    std::copy(a, a + half, sum.begin());
+    AddLimbsAt(sum.data(), sum.size(), 0, a + half, size - half);
+
+    std::vector<uint64_t> middle(2 * (half + 1), 0);
+    STATS_ALLOCATION(middle.size());
+    SquareKaratsuba(sum.data(), sum.size(), middle.data(), threshold);
+    SubtractLimbsAt(middle.data(), middle.size(), storage, 2 * half);
+    SubtractLimbsAt(middle.data(), middle.size(), storage + (2 * half), (2 * size) - (2 * half));
+
+    AddLimbsAt(storage, 2 * size, half, middle.data(), middle.size());
+}
+
+constexpr std::vector<uint64_t> SquareLimbs(const std::vector<uint64_t>& a, size_t threshold = BIGNUMBER_KARATSUBA_THRESHOLD) {
+    std::vector<uint64_t> storage(2 * a.size(), 0);
+    STATS_ALLOCATION(storage.size());
+    SquareKaratsuba(a.data(), a.size(), storage.data(), threshold);
+    TrimLimbs(storage);
+    return storage;
+}
+
+template <class Divisor>
+constexpr void DivideKnuth(const std::vector<uint64_t>& a, const Divisor& b, std::vector<uint64_t>& quotient, std::vector<uint64_t>& remainder) {  // b has >= 2 limbs
+    // Ak A < B
+    if (CompareLimbs(a, b) < 0) {
+        quotient = {0};
+        remainder = a;
+        return;
+    }
+    const size_t n = b.size();
+    const size_t m = a.size();
+
+    // Normalizacia: najvyssi limb delitela musi byt >= MODULO/2
+    const uint64_t factor = MODULO / (b[n-1] + 1);
+    std::vector<uint64_t> u = MultiplySmallLimbs(a, factor);
+    std::vector<uint64_t> v = MultiplySmallLimbs(b, factor);
+    u.resize(m + 1, 0);
+
+    quotient.assign((m - n) + 1, 0);
+    STATS_ALLOCATION(quotient.size());
+    for (size_t j = (m - n) + 1; j-- > 0;) {
+        CANCEL_POINT(j);
+        // Odhad cifry podielu z dvoch najvyssich limbov
+        uint64_t numerator = (u[j+n] * MODULO) + u[j+n-1];
+        uint64_t qhat = numerator / v[n-1];
+        uint64_t rhat = numerator % v[n-1];
+        while ((qhat >= MODULO) || ((qhat * v[n-2]) > ((rhat * MODULO) + u[j+n-2]))) {
+            qhat--;
+            rhat += v[n-1];
+            if (rhat >= MODULO) { break; }
+        }
+
+        // Odcitanie qhat * delitel od aktualnej casti delenca
+        uint64_t carrying = 0;
+        int64_t taking = 0;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t product = (qhat * v[i]) + carrying;
+            carrying = product / MODULO;
+            int64_t difference = static_cast<int64_t>(u[i+j]) - static_cast<int64_t>(product % MODULO) - taking;
+            taking = (difference < 0);
+            u[i+j] = (difference < 0) ? (difference + MODULO) : difference;
+        }
+        int64_t top = static_cast<int64_t>(u[j+n]) - static_cast<int64_t>(carrying) - taking;
+
+        // Odhad bol o 1 vacsi; Pripocitanie delitela naspat
+        if (top < 0) {
+            qhat--;
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; i++) {
+                uint64_t sum = u[i+j] + v[i] + carry;
+                u[i+j] = sum % MODULO;
+                carry = sum / MODULO;
+            }
+            top += carry;
+        }
+        u[j+n] = top;
+        quotient[j] = qhat;
+    }
+    TrimLimbs(quotient);
+
+    // Zvysok treba vydelit normalizacnym faktorom
+    u.resize(n);
+    TrimLimbs(u);
+    DivideSmallLimbs(u, factor);
+    remainder = std::move(u);
+}
+
+constexpr void DivideThreeHalves(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b, size_t half, std::vector<uint64_t>& quotient, std::vector<uint64_t>& remainder, size_t threshold);
+
+constexpr void DivideTwoByOne(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b, size_t n, std::vector<uint64_t>& quotient, std::vector<uint64_t>& remainder, size_t threshold) {  // a < b * MODULO^n, b normalized with n limbs
+    // Zakladny pripad: neparna alebo mala dlzka
+    if ((n % 2 == 1) || (n < threshold)) {
+        if (b.size() == 1) {
+            quotient = a;
+            remainder = {DivideSmallLimbs(quotient, b[0])};
+            return;
+        }
+        DivideKnuth(a, b, quotient, remainder);
+        return;
+    }
+    const size_t half = n / 2;
+
+    // [A1 A2 A3] / B, potom [R A4] / B
+    std::vector<uint64_t> high_quotient;
+    std::vector<uint64_t> rest;
+    DivideThreeHalves(SliceLimbs(a, half, 3 * half), b, half, high_quotient, rest, threshold);
+
+    std::vector<uint64_t> low_quotient;
+    DivideThreeHalves(AddLimbs(ShiftLimbs(rest, half), SliceLimbs(a, 0, half)), b, half, low_quotient, remainder, threshold);
+
+    quotient = AddLimbs(ShiftLimbs(high_quotient, half), low_quotient);
+}
+
+constexpr void DivideThreeHalves(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b, size_t half, std::vector<uint64_t>& quotient, std::vector<uint64_t>& remainder, size_t threshold) {  // a < b * MODULO^half, b has 2*half limbs
+    const std::vector<uint64_t> b1 = SliceLimbs(b, half, half);
+    const std::vector<uint64_t> b2 = SliceLimbs(b, 0, half);
+    const std::vector<uint64_t> a12 = SliceLimbs(a, half, 2 * half);
+
+    // Odhad podielu z hornych polovic
+    std::vector<uint64_t> rest;
+    if (CompareLimbs(SliceLimbs(a, 2 * half, half), b1) < 0) {
+        DivideTwoByOne(a12, b1, half, quotient, rest, threshold);
+    }
+    else {
+        // Podiel je MODULO^half - 1; Zvysok = A12 - Q*B1 = A12 + B1 - B1*MODULO^half
+        quotient.assign(half, MODULO - 1);
+        rest = SubtractLimbs(AddLimbs(a12, b1), ShiftLimbs(b1, half));
+    }
+
+    // R = [R1 A3] - Q*B2; Zaporny zvysok sa opravi najviac dvoma pripocitaniami B
+    std::vector<uint64_t> value = AddLimbs(ShiftLimbs(rest, half), SliceLimbs(a, 0, half));
+    const std::vector<uint64_t> subtrahend = MultiplyLimbs(quotient, b2);
+    while (CompareLimbs(value, subtrahend) < 0) {
+        quotient = SubtractLimbs(quotient, {1});
+        value = AddLimbs(value, b);
+    }
+    remainder = SubtractLimbs(value, subtrahend);
+}
+
+template <class Divisor>
+constexpr void DivideBurnikelZiegler(const std::vector<uint64_t>& a, const Divisor& b, std::vector<uint64_t>& quotient, std::vector<uint64_t>& remainder, size_t threshold) {
+    // Dlzka bloku n = j * 2^k, kde j < threshold; Delitel sa doplni nulami zdola
+    const size_t size = b.size();
+    size_t levels = 0;
+    while (((size + (static_cast<size_t>(1) << levels) - 1) >> levels) >= threshold) {
+        levels++;
+    }
+    const size_t n = ((size + (static_cast<size_t>(1) << levels) - 1) >> levels) << levels;
+    const size_t sigma = n - size;
+
+    // Normalizacia: najvyssi limb >= MODULO/2, dlzka presne n
+    const uint64_t factor = MODULO / (b[size-1] + 1);
+    const std::vector<uint64_t> divisor = ShiftLimbs(MultiplySmallLimbs(b, factor), sigma);
+    const std::vector<uint64_t> dividend = ShiftLimbs(MultiplySmallLimbs(a, factor), sigma);
+
+    // Pocet blokov delenca; Najvyssi blok musi byt mensi ako delitel
+    size_t blocks = std::max<size_t>(2, (dividend.size() + n - 1) / n);
+    if (CompareLimbs(SliceLimbs(dividend, (blocks - 1) * n, n), divisor) >= 0) {
+        blocks++;
+    }
+
+    std::vector<uint64_t> current = SliceLimbs(dividend, (blocks - 2) * n, 2 * n);
+    std::vector<uint64_t> result((blocks - 1) * n, 0);
+    STATS_ALLOCATION(result.size());
+    std::vector<uint64_t> rest;
+    for (size_t i = blocks - 1; i-- > 0;) {
+        std::vector<uint64_t> block_quotient;
+        DivideTwoByOne(current, divisor, n, block_quotient, rest, threshold);
+        std::copy(block_quotient.begin(), block_quotient.end(), result.begin() + (i * n));
+        if (i > 0) {
+            current = AddLimbs(ShiftLimbs(rest, n), SliceLimbs(dividend, (i - 1) * n, n));
+        }
+    }
+    TrimLimbs(result);
+    quotient = std::move(result);
+
+    // Zvysok: odstranenie posunu a normalizacneho faktora
+    remainder = SliceLimbs(rest, sigma, rest.size());
+    DivideSmallLimbs(remainder, factor);
+}
+
+template <class Divisor>
+constexpr void DivideLimbs(const std::vector<uint64_t>& a, const Divisor& b, std::vector<uint64_t>& quotient, std::vector<uint64_t>& remainder, size_t threshold = BIGNUMBER_BURNIKEL_ZIEGLER_THRESHOLD) {  // both trimmed, b != 0
+    // Ak A < B
+    if (CompareLimbs(a, b) < 0) {
+        quotient = {0};
+        remainder = a;
+        return;
+    }
+    // Delenie jednym limbom
+    if (b.size() == 1) {
+        quotient = a;
+        STATS_ALLOCATION(quotient.size());
+        remainder = {DivideSmallLimbs(quotient, b[0])};
+        return;
+    }
+    // Vyber algoritmu podla dlzky delitela a podielu
+    if (b.size() < threshold || (a.size() - b.size()) < threshold) {
+        DivideKnuth(a, b, quotient, remainder);
+    }
+    else {
+        DivideBurnikelZiegler(a, b, quotient, remainder, threshold);
+    }
+}
+
+
+// hashing: limbs are < 2^30, so two limbs fill one 64-bit word
+inline uint64_t HashLimbs(const std::vector<uint64_t>& limbs) {  // never 0 (0 marks an empty cache)
+    uint64_t hash = limbs.size() * 0x9E3779B97F4A7C15ull;
+    size_t i = 0;
+    for (; i + 1 < limbs.size(); i += 2) {
+        hash = (hash ^ (limbs[i] | (limbs[i + 1] << 32))) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 29;
+    }
+    if (i < limbs.size()) {
+        hash = (hash ^ limbs[i]) * 0xFF51AFD7ED558CCDull;
+        hash ^= hash >> 29;
+    }
+    // Finalizer z MurmurHash3 (fmix64)
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return (hash != 0) ? hash : 1;
+}
+
+
+// floating point conversion: 128-bit fixed point mantissa and binary exponent; the top limbs are exact,
+// lower limbs only scale by 10^(9k), so the error stays far below the 53-bit rounding position
+#define WIDE_FLOAT_ERROR (static_cast<WideLimb>(1) << 50)
+
+struct WideFloat  // mantissa * 2^exponent, bit 127 of mantissa is set; unless exact, |true value - mantissa| < WIDE_FLOAT_ERROR
+{
+    WideLimb mantissa;
+    int64_t exponent;
+    bool exact;
+};
+
+inline WideFloat NormalizeWide(WideLimb mantissa, int64_t exponent, bool exact) {  // mantissa != 0
+    const uint64_t high = static_cast<uint64_t>(mantissa >> 64);
+    const int shift = (high != 0) ? std::countl_zero(high) : 64 + std::countl_zero(static_cast<uint64_t>(mantissa));
+    return {mantissa << shift, exponent - shift, exact};
+}
+
+inline WideFloat MultiplyWide(const WideFloat& a, const WideFloat& b) {  // top 128 bits of the 256-bit product, truncated
+    const WideLimb a1 = a.mantissa >> 64;
+    const WideLimb a0 = static_cast<uint64_t>(a.mantissa);
+    const WideLimb b1 = b.mantissa >> 64;
+    const WideLimb b0 = static_cast<uint64_t>(b.mantissa);
+    const WideLimb p10 = a1 * b0;
+    const WideLimb p01 = a0 * b1;
+    const WideLimb middle = ((a0 * b0) >> 64) + static_cast<uint64_t>(p10) + static_cast<uint64_t>(p01);
+    WideLimb high = (a1 * b1) + (p10 >> 64) + (p01 >> 64) + (middle >> 64);
+    int64_t exponent = a.exponent + b.exponent + 128;
+
+    // Sucin dvoch normalizovanych cisel ma 255 alebo 256 bitov
+    if ((high >> 127) == 0) {
+        high = (high << 1) | (static_cast<uint64_t>(middle) >> 63);
+        exponent--;
+    }
+    return {high, exponent, false};
+}
+
+inline WideFloat DivideWide(const WideFloat& a, const WideFloat& b) {  // 128 quotient bits, truncated
+    WideLimb remainder = a.mantissa;
+    WideLimb quotient = 0;
+    int64_t exponent = a.exponent - b.exponent;
+    if (remainder >= b.mantissa) {
+        remainder -= b.mantissa;
+        quotient = 1;
+    }
+    // Delenie po bitoch, kym podiel nema 128 bitov; pretecenie zvysku sa pri odcitani vyrusi
+    while ((quotient >> 127) == 0) {
+        const bool overflow = (remainder >> 127) != 0;
+        remainder <<= 1;
+        quotient <<= 1;
+        exponent--;
+        if (overflow || remainder >= b.mantissa) {
+            remainder -= b.mantissa;
+            quotient |= 1;
+        }
+    }
+    return {quotient, exponent, a.exact && b.exact && remainder == 0};
+}
+
+inline WideFloat PowerOfModulo(size_t k) {  // MODULO^k
+    WideFloat result = NormalizeWide(1, 0, true);
+    WideFloat base = NormalizeWide(MODULO, 0, true);
+    while (k != 0) {
+        if (k & 1) { result = MultiplyWide(result, base); }
+        k >>= 1;
+        if (k != 0) { base = MultiplyWide(base, base); }
+    }
+    return result;
+}
+
+inline std::optional<std::pair<uint64_t, int64_t>> RoundWide(const WideFloat& value, int64_t min_exponent) {  // significand * 2^exponent rounded to 53 bits (fewer below 2^min_exponent), half to even; none if the error interval contains the rounding boundary
+    int64_t drop = 75;
+    if (value.exponent < min_exponent - drop) {
+        drop = min_exponent - value.exponent;
+    }
+    // Cele cislo je pod polovicou najmensieho kroku
+    if (drop > 128) {
+        return std::pair<uint64_t, int64_t>(0, min_exponent);
+    }
+    const WideLimb half = static_cast<WideLimb>(1) << (drop - 1);
+    const WideLimb low = (drop == 128) ? value.mantissa : (value.mantissa & ((half << 1) - 1));
+    uint64_t significand = (drop == 128) ? 0 : static_cast<uint64_t>(value.mantissa >> drop);
+
+    if (!value.exact) {
+        const WideLimb distance = (low > half) ? (low - half) : (half - low);
+        if (distance <= WIDE_FLOAT_ERROR) {
+            return std::nullopt;
+        }
+    }
+    if (low > half || (low == half && (significand & 1))) {
+        significand++;
+    }
+    int64_t exponent = value.exponent + drop;
+    if (significand == (static_cast<uint64_t>(1) << 53)) {
+        significand >>= 1;
+        exponent++;
+    }
+    return std::pair<uint64_t, int64_t>(significand, exponent);
+}
+
+
+// binary format v1, little-endian: version byte, flags byte (bit 0 = negative), 2 reserved bytes (0), uint32 limb count,
+// then count uint32 limbs in base MODULO; the highest limb is not 0 unless the value is 0 (encoded as one 0 limb)
+#define SERIAL_VERSION 1
+#define SERIAL_HEADER 8
+
+constexpr uint32_t ReadUInt32(const std::byte* data) {
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) | (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+constexpr void WriteUInt32(std::byte* data, uint32_t value) {
+    for (size_t i = 0; i < 4; i++) {
+        data[i] = static_cast<std::byte>(value >> (8 * i));
+    }
+}
+
+// read-only BigInteger over a serialized buffer (mmap, network, ...); limbs are decoded on access, never copied
+class BigIntegerView
+{
+public:
+    class LimbIterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = uint64_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = uint64_t;
+
+        constexpr LimbIterator() = default;
+        constexpr explicit LimbIterator(const std::byte* position) : position(position) {};
+
+        constexpr uint64_t operator*() const { return ReadUInt32(this->position); }
+        constexpr uint64_t operator[](difference_type i) const { return ReadUInt32(this->position + (4 * i)); }
+
+        constexpr LimbIterator& operator++() { this->position += 4; return *this; }
+        constexpr LimbIterator operator++(int) { LimbIterator old = *this; this->position += 4; return old; }
+        constexpr LimbIterator& operator--() { this->position -= 4; return *this; }
+        constexpr LimbIterator operator--(int) { LimbIterator old = *this; this->position -= 4; return old; }
+        constexpr LimbIterator& operator+=(difference_type n) { this->position += 4 * n; return *this; }
+        constexpr LimbIterator& operator-=(difference_type n) { this->position -= 4 * n; return *this; }
+
+        friend constexpr LimbIterator operator+(LimbIterator it, difference_type n) { it += n; return it; }
+        friend constexpr LimbIterator operator+(difference_type n, LimbIterator it) { it += n; return it; }
+        friend constexpr LimbIterator operator-(LimbIterator it, difference_type n) { it -= n; return it; }
+        friend constexpr difference_type operator-(const LimbIterator& lhs, const LimbIterator& rhs) { return (lhs.position - rhs.position) / 4; }
+        friend constexpr bool operator==(const LimbIterator& lhs, const LimbIterator& rhs) { return lhs.position == rhs.position; }
+        friend constexpr auto operator<=>(const LimbIterator& lhs, const LimbIterator& rhs) { return lhs.position <=> rhs.position; }
+
+    private:
+        const std::byte* position = nullptr;
+    };
+
+    // constructors
+    constexpr explicit BigIntegerView(std::span<const std::byte> buffer) {  // validates one record at the start of 'buffer'
+        if (buffer.size() < SERIAL_HEADER || static_cast<uint8_t>(buffer[0]) != SERIAL_VERSION) {
+            throw std::runtime_error("Unsupported BigInteger serialization!");
+        }
+        const uint8_t flags = static_cast<uint8_t>(buffer[1]);
+        const size_t count = ReadUInt32(buffer.data() + 4);
+        if ((flags & ~1) != 0 || buffer[2] != std::byte{0} || buffer[3] != std::byte{0} || count == 0 || (buffer.size() - SERIAL_HEADER) / 4 < count) {
+            throw std::runtime_error("Invalid BigInteger serialization!");
+        }
+        this->limbs = buffer.data() + SERIAL_HEADER;
+        this->count = count;
+        this->negative = (flags & 1) != 0;
+
+        // Limby musia byt < MODULO, najvyssi nenulovy; 0 nema znamienko
+        for (size_t i = 0; i < count; i++) {
+            if ((*this)[i] >= MODULO) {
+                throw std::runtime_error("Invalid BigInteger serialization!");
+            }
+        }
+        if ((count > 1 && (*this)[count - 1] == 0) || (this->is_zero() && this->negative)) {
+            throw std::runtime_error("Invalid BigInteger serialization!");
+        }
+    };
+
+    // limbs (base MODULO, little-endian)
+    constexpr size_t size() const { return this->count; }
+    constexpr uint64_t operator[](size_t i) const { return ReadUInt32(this->limbs + (4 * i)); }
+    constexpr LimbIterator begin() const { return LimbIterator(this->limbs); }
+    constexpr LimbIterator end() const { return LimbIterator(this->limbs + (4 * this->count)); }
+    constexpr LimbIterator data() const { return this->begin(); }
+
+    constexpr bool is_negative() const { return this->negative; }
+    constexpr bool is_zero() const { return this->count == 1 && (*this)[0] == 0; }
+    constexpr size_t serialized_size() const { return SERIAL_HEADER + (4 * this->count); }  // offset of the next record in the buffer
+
+    constexpr BigIntegerView operator-() const {
+        BigIntegerView negated = *this;
+        negated.negative = !this->negative && !this->is_zero();
+        return negated;
+    };
+
+    friend constexpr bool operator==(const BigIntegerView& lhs, const BigIntegerView& rhs) {
+        return lhs.negative == rhs.negative && CompareLimbs(lhs, rhs) == 0;
+    };
+    friend constexpr std::strong_ordering operator<=>(const BigIntegerView& lhs, const BigIntegerView& rhs) {
+        // Rozne znamienka; Rovnake znamienka: zaporne cisla maju opacne poradie absolutnych hodnot
+        if (lhs.negative != rhs.negative) {
+            return lhs.negative ? std::strong_ordering::less : std::strong_ordering::greater;
+        }
+        const int comparison = lhs.negative ? CompareLimbs(rhs, lhs) : CompareLimbs(lhs, rhs);
+        return comparison <=> 0;
+    };
+
+private:
+    const std::byte* limbs;
+    size_t count;
+    bool negative;
+};
+
+
+// compile-time literal: "123"_big
+template <size_t N>
+struct BigIntegerLiteral
+{
+    constexpr BigIntegerLiteral(const char (&str)[N]) {
+        for (size_t i = 0; i < N; i++) {
+            this->text[i] = str[i];
+        }
+    }
+
+    char text[N];
+};
+
+template <BigIntegerLiteral S>
+struct BigIntegerLiteralTable;
+
+
+class MontgomeryContext;
+class BigRational;
+enum class DecimalFraction { Zero, BelowHalf, Half, AboveHalf };  // discarded part, relative to one unit of the last kept digit
+enum class RoundingMode { Down, Up, Floor, Ceiling, HalfUp, HalfDown, HalfEven };  // Down/Up = toward/away from zero
+class BigDecimal;
+
+class BigInteger
+{
+public:
+    // constructors
+    constexpr BigInteger()
+        : numbers{0}
+        , negative(false)
+        , zero(true)
+    {}
+    
+    constexpr BigInteger(int64_t n)
+        : numbers()
+        , negative(false)
+        , zero(false)
+    {   
+        if (n == 0) {
+            numbers.push_back(0);
+            this->zero = true;
+            return;
+        }
+        // Ulozenie zaporneho znamienka
+        if (n < 0) {
+            this->negative = true;
+            n = -n;
+        }
+        // Rýchle vybavenie čísla pod limitom
+        if (n < MODULO) {
+            numbers.push_back(n);
+            return;
+        }
+        // Ak číslo presahuje limit MODULO
+        while (n != 0) {
+            numbers.push_back(n % MODULO);
+            n /= MODULO;
+        }
+    }
+    
+    constexpr explicit BigInteger(const std::string& str)
+        : numbers()
+        , negative(false)
+        , zero(false)
+    {
+        // Zachytenie prazdneho stringu
+        if (str.empty()) {
+            throw std::runtime_error("Empty BigInteger!");
+        }
+        // Ak sa maju overit iba ' ', tak staci iba: str.front/back() == ' '
+        if (IsSpace(str.front()) || IsSpace(str.back())) {
+            throw std::runtime_error("White space(s) in BigInteger!");
+        }
+
+        uint64_t position = 0;
+        bool negative = false;
+        
+        // Overenie znaku +/-
+        if (str[0] == '+') {
+            position = 1;
+        }
+        else if (str[0] == '-') {
+            position = 1;
+            negative = true;
+        }
+
+        // Ak string ma iba jeden znak (znamienko)
+        if (position == str.size()) {
+            throw std::runtime_error("No digit(s) in BigInteger!");
+        }
+        // Overenie, ze v stringu su iba cifry
+        for (size_t i = position; i < str.size(); i++) {
+            if (!IsDigit(str[i])) {
+                throw std::runtime_error("Only digit(s) allowed in BigInteger!");
+            }
+        }
+
+        // Hladanie prveho nenuloveho znaku
+        size_t non_zero_position = str.find_first_not_of('0', position);
+
+        // Ak same 0 v stringu
+        if (non_zero_position == std::string::npos) {
+            this->numbers.push_back(0);
+            this->zero = true;
+            return;
+        }
+        this->numbers.reserve(((str.size() - non_zero_position) + DIGITS - 1) / DIGITS);
+
+        // Rozdelenie stringu od konca, po castiach, do vektora; Bez substr/stoull, aby islo aj v constexpr
+        for (int64_t i = str.size(); i > static_cast<int64_t>(non_zero_position); i -= DIGITS) {
+            int64_t start = std::max<int64_t>(i - DIGITS, non_zero_position);
+            uint64_t part = 0;
+            for (int64_t j = start; j < i; j++) {
+                part = (part * 10) + (str[j] - '0');
+            }
+            this->numbers.push_back(part);
+        }
+
+        // Priradenie znamienka
+        this->negative = negative;
+    };
+    
+    // move
+    constexpr BigInteger(BigInteger&& other) noexcept
+        : numbers(std::move(other.numbers))
+        , negative(other.negative)
+        , zero(other.zero)
+        , hash_code(CachedHash(other))
+    {
+        other.negative = false;
+        other.zero = false;
+        other.hash_code = 0;
+    }
+
+    constexpr BigInteger& operator=(BigInteger&& other) noexcept {
+        // Ide o ten isty objekt
+        if (this == &other) {
+            return *this;
+        }
+        this->numbers = std::move(other.numbers);
+        this->negative = other.negative;
+        this->zero = other.zero;
+        this->hash_code = CachedHash(other);
+
+        other.negative = false;
+        other.zero = false;
+        other.hash_code = 0;
+        
+        return *this;
+    };
+
+    // copy
+    constexpr BigInteger(const BigInteger& other)
+        : numbers(other.numbers)
+        , negative(other.negative)
+        , zero(other.zero)
+        , hash_code(CachedHash(other))
+    {}
+    
+    constexpr BigInteger& operator=(const BigInteger& rhs) {
+        // Ide o ten isty objekt
+        if (this == &rhs) {
+            return *this;
+        }
+        this->numbers = rhs.numbers;
+        this->negative = rhs.negative;
+        this->zero = rhs.zero;
+        this->hash_code = CachedHash(rhs);
+        
+        return *this;
+    };
+
+    // from BigIntegerView (copies the limbs)
+    constexpr explicit BigInteger(const BigIntegerView& view)
+        : numbers(view.begin(), view.end())
+        , negative(view.is_negative())
+        , zero(view.is_zero())
+    {}
+    
+
+    // unary operators
+    constexpr const BigInteger& operator+() const {
+        return *this;
+    };
+
+    constexpr BigInteger operator-() const {
+        if (this->zero) {
+            return *this;
+        }
+        // Potreba vytvorenia noveho objektu + zmena znamienka
+        BigInteger copied = *this;
+        copied.negative = !(this->negative);
+        
+        return copied;
+    };
+    
+    
+    // binary arithmetics operators
+    constexpr BigInteger& operator+=(const BigInteger& rhs) {
+        STATS_SCOPE(BigOperation::Add, std::max(this->numbers.size(), rhs.numbers.size()));
+        AddSigned(*this, rhs.numbers, rhs.negative);
+        return *this;
+    };
+
+    constexpr BigInteger& operator-=(const BigInteger& rhs) {
+        STATS_SCOPE(BigOperation::Subtract, std::max(this->numbers.size(), rhs.numbers.size()));
+        AddSigned(*this, rhs.numbers, !rhs.negative);
+        return *this;
+    };
+
+    constexpr BigInteger& operator*=(const BigInteger& rhs) {
+        // Ak 0*B
+        if (this->zero) {
+            return *this;
+        }
+        // Ak A*0
+        if (rhs.zero) {
+            SetToZero(*this);
+            return *this;
+        }
+        // Ak 1*B
+        if (IsOne(*this)) {
+            bool old_negative = this->negative;
+            *this = rhs;
+            this->negative = !(old_negative == rhs.negative);
+            return *this;
+        }
+        // Ak A*1
+        if (IsOne(rhs)) {
+            this->negative = !(this->negative == rhs.negative);
+            return *this;
+        }
+
+        // Nastavenie spravneho znamienka
+        this->negative = !(this->negative == rhs.negative);
+
+        STATS_SCOPE(BigOperation::Multiply, std::max(this->numbers.size(), rhs.numbers.size()));
+        this->hash_code = 0;
+        // Vyber algoritmu (skolske / Karatsuba) podla velkosti, pozri MultiplyLimbs; A*A ma vlastny kernel
+        if (this == &rhs) {
+            this->numbers = SquareLimbs(this->numbers);
+        }
+        else {
+            this->numbers = MultiplyLimbs(this->numbers, rhs.numbers);
+        }
+        
+        return *this;
+    };
+
+    constexpr BigInteger& operator/=(const BigInteger& rhs) {
+        // Ak A/0
+        if (rhs.zero) {
+            throw std::runtime_error("Dividing by 0!");
+        }
+        // Ak 0/B 
+        if (this->zero) {
+            return *this;
+        }
+        
+        // Ak A/1
+        if (IsOne(rhs)) {
+            this->negative = !(this->negative == rhs.negative);
+            return *this;
+        }
+        // Ak A/B, kde A = B, ich vektory
+        if (EqualVectors(*this, rhs)) {
+            this->numbers = {1};
+            this->hash_code = 0;
+            this->negative = !(this->negative == rhs.negative);
+            return *this;
+        }
+        // Ak A/B, kde |A| < |B|
+        if (CompareLimbs(this->numbers, rhs.numbers) < 0) {
+            SetToZero(*this);
+            return *this;
+        }
+
+        DivisionModuloLogic(*this, rhs.numbers, rhs.negative, true);
+
+        return *this;
+    };
+
+    constexpr BigInteger& operator%=(const BigInteger& rhs) {
+        // Ak A%0
+        if (rhs.zero) {
+            throw std::runtime_error("Modulling by 0!");
+        }
+        // Ak 0%B 
+        if (this->zero) {
+            return *this;
+        }
+        // Ak A%1 alebo A%B, kde A = B, ich vektory
+        if (IsOne(rhs) || EqualVectors(*this, rhs)) {
+            SetToZero(*this);
+            return *this;
+        }
+        // Ak A%B, kde |A| < |B|
+        if (CompareLimbs(this->numbers, rhs.numbers) < 0) {
+            return *this;
+        }
+
+        DivisionModuloLogic(*this, rhs.numbers, rhs.negative, false);
+
+        return *this;
+    };
+
+    // arithmetics with a BigIntegerView operand; the view's limbs are read in place
+    constexpr BigInteger& operator+=(const BigIntegerView& rhs) {
+        STATS_SCOPE(BigOperation::Add, std::max(this->numbers.size(), rhs.size()));
+        AddSigned(*this, rhs, rhs.is_negative());
+        return *this;
+    };
+
+    constexpr BigInteger& operator-=(const BigIntegerView& rhs) {
+        STATS_SCOPE(BigOperation::Subtract, std::max(this->numbers.size(), rhs.size()));
+        AddSigned(*this, rhs, !rhs.is_negative());
+        return *this;
+    };
+
+    constexpr BigInteger& operator*=(const BigIntegerView& rhs) {
+        // Ak 0*B alebo A*0
+        if (this->zero || rhs.is_zero()) {
+            SetToZero(*this);
+            return *this;
+        }
+        STATS_SCOPE(BigOperation::Multiply, std::max(this->numbers.size(), rhs.size()));
+        this->negative = !(this->negative == rhs.is_negative());
+        this->numbers = MultiplyLimbs(this->numbers, rhs);
+        this->hash_code = 0;
+        return *this;
+    };
+
+    constexpr BigInteger& operator/=(const BigIntegerView& rhs) {
+        // Ak A/0
+        if (rhs.is_zero()) {
+            throw std::runtime_error("Dividing by 0!");
+        }
+        if (!this->zero) {
+            DivisionModuloLogic(*this, rhs, rhs.is_negative(), true);
+        }
+        return *this;
+    };
+
+    constexpr BigInteger& operator%=(const BigIntegerView& rhs) {
+        // Ak A%0
+        if (rhs.is_zero()) {
+            throw std::runtime_error("Modulling by 0!");
+        }
+        if (!this->zero) {
+            DivisionModuloLogic(*this, rhs, rhs.is_negative(), false);
+        }
+        return *this;
+    };
+
+    // binary serialization (format: see BigIntegerView)
+    size_t serialized_size() const {
+        return SERIAL_HEADER + (4 * this->numbers.size());
+    };
+
+    size_t serialize(std::span<std::byte> buffer) const {  // returns bytes written
+        if (this->numbers.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("BigInteger too large to serialize!");
+        }
+        if (buffer.size() < this->serialized_size()) {
+            throw std::runtime_error("Buffer too small for BigInteger!");
+        }
+        buffer[0] = static_cast<std::byte>(SERIAL_VERSION);
+        buffer[1] = static_cast<std::byte>(this->negative ? 1 : 0);
+        buffer[2] = std::byte{0};
+        buffer[3] = std::byte{0};
+        WriteUInt32(buffer.data() + 4, static_cast<uint32_t>(this->numbers.size()));
+        for (size_t i = 0; i < this->numbers.size(); i++) {
+            WriteUInt32(buffer.data() + SERIAL_HEADER + (4 * i), static_cast<uint32_t>(this->numbers[i]));
+        }
+        return this->serialized_size();
+    };
+
+    std::vector<std::byte> serialize() const {
+        std::vector<std::byte> buffer(this->serialized_size());
+        this->serialize(buffer);
+        return buffer;
+    };
+
+    static BigInteger deserialize(std::span<const std::byte> buffer) {
+        return BigInteger(BigIntegerView(buffer));
+    };
+
+    // text in bases 2 to 36, digits above 9 are letters (lowercase on output, any case on input)
+    std::string to_string(int base = 10) const;
+    static BigInteger from_string(const std::string& str, int base = 10);
+
+#if SUPPORT_FILES == 1
+    // decimal text files via mmap; blocks of limbs are converted in parallel (threads = 0: hardware concurrency)
+    static BigInteger load_decimal(const std::string& path, size_t threads = 0);
+    void save_decimal(const std::string& path, size_t threads = 0) const;
+#endif
+
+    // sqrt
+    double sqrt() const {
+        // Ak zaporne cislo
+        if (this->negative) {
+            throw std::runtime_error("No SQRT of negative BigInteger");
+        }
+        // Ak sqrt(0)
+        if (this->zero) {
+            return 0;
+        }
+        // Ak sqrt(1)
+        if (IsOne(*this)) {
+            return 1;
+        }
+
+        // sqrt(m * 2^e) = sqrt(m) * 2^(e/2) pre parne e
+        auto [mantissa, exponent] = frexp(*this);
+        if (exponent & 1) {
+            mantissa *= 2;
+            exponent--;
+        }
+        if (exponent / 2 > std::numeric_limits<double>::max_exponent) {
+            throw std::runtime_error("BigInteger too big!");
+        }
+        return std::ldexp(std::sqrt(mantissa), static_cast<int>(exponent / 2));
+    };
+
+    double to_double() const;  // correctly rounded (half to even), throws past the double range
+
+    // hashing; the limb hash is cached in the object and dropped whenever the limbs change
+    size_t hash() const noexcept {
+        std::atomic_ref<uint64_t> cached(this->hash_code);
+        uint64_t value = cached.load(std::memory_order_relaxed);
+        if (value == 0) {
+            value = HashLimbs(this->numbers);
+            cached.store(value, std::memory_order_relaxed);
+        }
+        return static_cast<size_t>(this->negative ? ~value : value);
+    };
+
+#if SUPPORT_MORE_OPS == 1
+    BigInteger isqrt() const;  // floor(sqrt), Newton from a double-precision seed
+
+    bool is_prime(size_t k) const { // use rabbin-miller test with k rounds (on top of baillie-psw)
+        return is_prime(k, RandomEngine());
+    };
+
+    template <class URBG>
+    bool is_prime(size_t k, URBG& rng) const { // trial division + baillie-psw + k rounds of rabbin-miller
+        return IsProbablePrime(*this, k, rng);
+    };
+#endif
+
+private:
+    std::vector<uint64_t> numbers;
+    bool negative;
+    bool zero;
+    mutable uint64_t hash_code = 0;  // HashLimbs(numbers), 0 = not computed yet
+
+    static constexpr uint64_t CachedHash(const BigInteger& other) {  // other.hash_code; hash() may store it concurrently on a shared const value
+        // GCC: mutable member sa v constexpr neda citat
+        if (std::is_constant_evaluated()) {
+            return 0;
+        }
+        return std::atomic_ref<uint64_t>(other.hash_code).load(std::memory_order_relaxed);
+    }
+
+    static constexpr bool IsSpace(char c) {
+        return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\v') || (c == '\f') || (c == '\r');
+    }
+
+    static constexpr bool IsDigit(char c) {
+        return (c >= '0') && (c <= '9');
+    }
+
+    static std::mt19937_64& RandomEngine() {
+        // Jeden engine na vlakno, inicializovany iba raz
+        static thread_local std::mt19937_64 engine(std::random_device{}());
+        return engine;
+    }
+
+    friend constexpr BigInteger operator+(BigInteger lhs, const BigInteger& rhs);
+    friend constexpr BigInteger operator-(BigInteger lhs, const BigInteger& rhs);
+    friend constexpr BigInteger operator*(BigInteger lhs, const BigInteger& rhs);
+    friend constexpr BigInteger operator/(BigInteger lhs, const BigInteger& rhs);
+    friend constexpr BigInteger operator%(BigInteger lhs, const BigInteger& rhs);
+
+    friend constexpr bool operator==(const BigInteger& lhs, const BigInteger& rhs);
+    friend constexpr bool operator!=(const BigInteger& lhs, const BigInteger& rhs);
+    friend constexpr bool operator<(const BigInteger& lhs, const BigInteger& rhs);
+    friend constexpr bool operator>(const BigInteger& lhs, const BigInteger& rhs);
+    friend constexpr bool operator<=(const BigInteger& lhs, const BigInteger& rhs);
+    friend constexpr bool operator>=(const BigInteger& lhs, const BigInteger& rhs);
+    friend std::ostream& operator<<(std::ostream& lhs, const BigInteger& rhs);
+
+    template <class Limbs> friend constexpr void AddSigned(BigInteger& lhs, const Limbs& rhs, bool rhs_negative);
+    template <class Limbs> friend constexpr void DivisionModuloLogic(BigInteger& lhs, const Limbs& rhs, bool rhs_negative, bool divison);
+    friend constexpr bool operator==(const BigInteger& lhs, const BigIntegerView& rhs);
+    friend constexpr std::strong_ordering operator<=>(const BigInteger& lhs, const BigIntegerView& rhs);
+    friend constexpr std::pair<BigInteger, BigInteger> divmod(const BigInteger& lhs, const BigInteger& rhs);
+    friend constexpr BigInteger EuclidLehmer(BigInteger a, BigInteger b, BigInteger* cofactor);
+    friend constexpr bool EqualVectors(const BigInteger& lhs, const BigInteger& rhs);
+    friend constexpr void SetToZero(BigInteger& biginteger);
+    friend constexpr void SetToOne(BigInteger& biginteger);
+    friend constexpr bool IsOne(const BigInteger& biginteger);
+    friend constexpr bool GetNegative(const BigInteger& biginteger);
+    friend constexpr void SetNegative(BigInteger& biginteger, bool value);
+    friend constexpr bool GetZero(const BigInteger& biginteger);
+    friend inline WideFloat ToWideFloat(const BigInteger& biginteger);
+    friend inline std::pair<double, int64_t> frexp(const BigInteger& biginteger);
+    friend inline void MultiplyPow10(BigInteger& biginteger, uint64_t exponent);
+    friend inline std::pair<BigInteger, DecimalFraction> DividePow10(const BigInteger& biginteger, uint64_t exponent);
+
+    template <class URBG> friend BigInteger random_below(const BigInteger& bound, URBG& rng);
+    template <class URBG> friend bool IsProbablePrime(const BigInteger& n, size_t k, URBG& rng, MontgomeryContext& context);
+    friend inline BigInteger next_prime(const BigInteger& x);
+    friend inline BigInteger prev_prime(const BigInteger& x);
+    friend inline std::vector<BigInteger> primes_in_range(const BigInteger& lo, const BigInteger& hi);
+    friend inline uint64_t RemainderSmall(const BigInteger& biginteger, uint64_t divisor);
+    friend inline void ToRadixChunks(const BigInteger& value, const std::vector<BigInteger>& powers, size_t level, uint64_t chunk, uint64_t* out);
+    friend inline BigInteger FromRadixChunks(const std::vector<uint64_t>& chunks, uint64_t chunk);
+    friend inline std::vector<uint32_t> ToBinaryWords(const BigInteger& biginteger);
+    friend inline std::optional<bool> TrialDivision(const BigInteger& n);
+    friend inline std::optional<uint64_t> ToUInt64(const BigInteger& biginteger);
+    friend inline int JacobiSmall(int64_t a, const BigInteger& n);
+    friend class MontgomeryContext;
+    friend class FixedBasePow;
+    friend class BigAccumulator;
+    friend inline BigInteger PowWords(const BigInteger& base, const std::vector<uint32_t>& exponent);
+    friend inline BigInteger pow_mod(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus);
+    friend inline void SimplifyNumber(BigRational& bigrational);
+    template <size_t Bits> friend class FixedBigUInt;
+    template <BigIntegerLiteral S> friend struct BigIntegerLiteralTable;
+};
+
+constexpr BigInteger operator+(BigInteger lhs, const BigInteger& rhs) { lhs += rhs; return lhs; };
+constexpr BigInteger operator-(BigInteger lhs, const BigInteger& rhs) { lhs -= rhs; return lhs; };
+constexpr BigInteger operator*(BigInteger lhs, const BigInteger& rhs) { lhs *= rhs; return lhs; };
+constexpr BigInteger operator/(BigInteger lhs, const BigInteger& rhs) { lhs /= rhs; return lhs; };
+constexpr BigInteger operator%(BigInteger lhs, const BigInteger& rhs) { lhs %= rhs; return lhs; };
+
+constexpr BigInteger operator+(BigInteger lhs, const BigIntegerView& rhs) { lhs += rhs; return lhs; };
+constexpr BigInteger operator-(BigInteger lhs, const BigIntegerView& rhs) { lhs -= rhs; return lhs; };
+constexpr BigInteger operator*(BigInteger lhs, const BigIntegerView& rhs) { lhs *= rhs; return lhs; };
+constexpr BigInteger operator/(BigInteger lhs, const BigIntegerView& rhs) { lhs /= rhs; return lhs; };
+constexpr BigInteger operator%(BigInteger lhs, const BigIntegerView& rhs) { lhs %= rhs; return lhs; };
+constexpr BigInteger operator+(const BigIntegerView& lhs, BigInteger rhs) { rhs += lhs; return rhs; };
+constexpr BigInteger operator*(const BigIntegerView& lhs, BigInteger rhs) { rhs *= lhs; return rhs; };
+constexpr BigInteger operator-(const BigIntegerView& lhs, const BigInteger& rhs) { return BigInteger(lhs) - rhs; };
+constexpr BigInteger operator/(const BigIntegerView& lhs, const BigInteger& rhs) { return BigInteger(lhs) / rhs; };
+constexpr BigInteger operator%(const BigIntegerView& lhs, const BigInteger& rhs) { return BigInteger(lhs) % rhs; };
+
+constexpr bool operator==(const BigInteger& lhs, const BigIntegerView& rhs) {
+    return lhs.negative == rhs.is_negative() && CompareLimbs(lhs.numbers, rhs) == 0;
+};
+constexpr std::strong_ordering operator<=>(const BigInteger& lhs, const BigIntegerView& rhs) {
+    // Rozne znamienka; Rovnake znamienka: zaporne cisla maju opacne poradie absolutnych hodnot
+    if (lhs.negative != rhs.is_negative()) {
+        return lhs.negative ? std::strong_ordering::less : std::strong_ordering::greater;
+    }
+    const int comparison = lhs.negative ? CompareLimbs(rhs, lhs.numbers) : CompareLimbs(lhs.numbers, rhs);
+    return comparison <=> 0;
+};
+
+constexpr bool operator==(const BigInteger& lhs, const BigInteger& rhs) {
+    // Znamienka sa musia rovnat; Takisto vsetky cisla vo vektore a ich pocet sa musia rovnat
+    return ((lhs.negative == rhs.negative) && (lhs.numbers == rhs.numbers));
+};
+constexpr bool operator!=(const BigInteger& lhs, const BigInteger& rhs) {
+    // Spravime negaciu, cize 'lhs' sa musi rovnat 'rhs'; Samotna negacia musi byt znegovana, aby to platilo.
+    return !(lhs == rhs);
+};
+constexpr bool operator<(const BigInteger& lhs, const BigInteger& rhs) {
+    // Rozne znamienka; Samotna hodnota lhs.negative hovori vysledok
+    if (lhs.negative != rhs.negative) {
+        return lhs.negative;
+    }
+
+    // Rovnake znamienka; Rozne velkosti vektorov
+    if (lhs.numbers.size() != rhs.numbers.size()) {
+        // Ak cisla ZAPORNE, tak velkost vektora 'lhs' musi byt vacsia
+        if (lhs.negative) {
+            return (lhs.numbers.size() > rhs.numbers.size());
+        }
+        // Ak cisla KLADNE, tak velkost vektora 'lhs' musi byt mensia
+        else {
+            return (lhs.numbers.size() < rhs.numbers.size());
+        }
+    }
+
+    // Rovnake znamienka; Rovnake velkosti vektorov
+    for (int64_t i = lhs.numbers.size() - 1; i >= 0; i--) {
+        // Ak su cisla rozne
+        if (lhs.numbers[i] != rhs.numbers[i]) {
+            // Ak cisla ZAPORNE, tak 'lhs' cislo musi byt vacsie
+            if (lhs.negative) {
+                return (lhs.numbers[i] > rhs.numbers[i]);
+            }
+            // Ak cisla KLADNE, tak 'lhs' cislo musi byt mensie
+            else {
+                return (lhs.numbers[i] < rhs.numbers[i]);
+            }
+        }
+    }
+
+    return false;
+};
+constexpr bool operator>(const BigInteger& lhs, const BigInteger& rhs) {
+    // Ak 'lhs' ma byt vacsie ako 'rhs', tak potom 'rhs' musi byt mensie ako 'lhs'
+    return (rhs < lhs);
+};
+constexpr bool operator<=(const BigInteger& lhs, const BigInteger& rhs) {
+    // Spravime negaciu, cize 'lhs' musi byt vacsie ako 'rhs'; Samotna negacia musi byt znegovana, aby to platilo.
+    return !(lhs > rhs);
+};
+constexpr bool operator>=(const BigInteger& lhs, const BigInteger& rhs) {
+    // Spravime negaciu, cize 'lhs' musi byt mensie ako 'rhs'; Samotna negacia musi byt znegovana, aby to platilo.
+    return !(lhs < rhs);
+};
+inline std::ostream& operator<<(std::ostream& os, const BigInteger& rhs) {
+    // std::hex / std::oct; std::showbase a std::uppercase ako pri int
+    const std::ios_base::fmtflags basefield = os.flags() & std::ios_base::basefield;
+    if (basefield == std::ios_base::hex || basefield == std::ios_base::oct) {
+        const bool hex = (basefield == std::ios_base::hex);
+        std::string text = rhs.to_string(hex ? 16 : 8);
+        if ((os.flags() & std::ios_base::uppercase) && hex) {
+            std::transform(text.begin(), text.end(), text.begin(), [](char c) { return static_cast<char>(std::toupper(static_cast<unsigned char>(c))); });
+        }
+        if ((os.flags() & std::ios_base::showbase) && !rhs.zero) {
+            text.insert(rhs.negative ? 1 : 0, hex ? ((os.flags() & std::ios_base::uppercase) ? "0X" : "0x") : "0");
+        }
+        os << text;
+        return os;
+    }
+
+    // Ak cislo je 0
+    if (rhs.zero) {
+        os << 0;
+        return os;
+    }
+    // Ak cislo zaporne, tak vypis znamienka
+    if (rhs.negative) {
+        os << '-';
+    }
+    // Ak cislo je 1
+    if (IsOne(rhs)) {
+        os << 1;
+        return os;
+    }
+
+    // Posledna, respektive prva cast cisla sa vypise bez prefixovych 0-ul
+    os << rhs.numbers.back();
+    // Vsetky dalsie casti cisla na vypise aj s prefixovymi 0-mi
+    for (int64_t i = rhs.numbers.size() - 2; i >= 0; i--) {
+        CANCEL_POINT(i);
+        os << std::setw(9) << std::setfill('0') << rhs.numbers[i];
+    }
+
+    return os;
+};
+
+template <class Limbs>
+constexpr void AddSigned(BigInteger& lhs, const Limbs& rhs, bool rhs_negative) {  // lhs += rhs, where rhs has sign 'rhs_negative'
+    // Ak A+0
+    if (rhs.size() == 1 && rhs[0] == 0) {
+        return;
+    }
+    lhs.hash_code = 0;
+    // Ak 0+B
+    if (lhs.zero) {
+        lhs.numbers.assign(rhs.begin(), rhs.end());
+        lhs.negative = rhs_negative;
+        lhs.zero = false;
+        return;
+    }
+
+    // Rovnake znamienka; Scitanie absolutnych hodnot
+    if (lhs.negative == rhs_negative) {
+        // Resize vektora na znamu velkost
+        lhs.numbers.resize(std::max(lhs.numbers.size(), rhs.size()), 0);
+
+        uint64_t carrying = 0;
+        // Pripocitavanie aj 'rhs' pokial je, inak iba pripocitanie 'lhs' ku carrying
+        for (size_t i = 0; i < lhs.numbers.size(); i++) {
+            if (i < rhs.size()) {
+                carrying += rhs[i];
+            }
+            // Ak sa uz nepripocitava z 'rhs'
+            else {
+                // Identifikovanie mozneho predcasneho ukoncenie
+                if (carrying == 0) { break; }
+            }
+            carrying += lhs.numbers[i];
+            lhs.numbers[i] = carrying % MODULO;
+            carrying /= MODULO;
+        }
+
+        // Pridanie zvysku do vektora z posledneho scitania
+        if (carrying > 0) {
+            lhs.numbers.push_back(carrying);
+        }
+        return;
+    }
+
+    // Rozne znamienka; Odcitanie mensej absolutnej hodnoty od vacsej
+    const int comparison = CompareLimbs(lhs.numbers, rhs);
+    // Ak |A| = |B|; Vysledok je 0
+    if (comparison == 0) {
+        SetToZero(lhs);
+        return;
+    }
+    // Ak |A| < |B|; Vysledok je |B| - |A| so znamienkom 'rhs'
+    if (comparison < 0) {
+        std::vector<uint64_t> difference(rhs.begin(), rhs.end());
+        STATS_ALLOCATION(difference.size());
+        SubtractLimbsAt(difference.data(), difference.size(), lhs.numbers.data(), lhs.numbers.size());
+        TrimLimbs(difference);
+        lhs.numbers = std::move(difference);
+        lhs.negative = rhs_negative;
+        return;
+    }
+
+    uint64_t taking = 0;
+    // Odcitavanie 'taking' a 'rhs' pokial je
+    for (size_t i = 0; i < lhs.numbers.size(); i++) {
+        int64_t difference = lhs.numbers[i] - taking;
+        if (i < rhs.size()) {
+            difference -= rhs[i];
+        }
+        // Ak sa uz neodcitava z 'rhs'
+        else {
+            // Identifikovanie mozneho predcasneho ukoncenie
+            if (static_cast<uint64_t>(difference) == lhs.numbers[i]) {
+                break;
+            }
+        }
+        // Musime odcitat 1 z nasledujuceho + opravit 'difference'
+        if (difference < 0) {
+            difference += MODULO;
+            taking = 1;
+        }
+        // Nemusime odcitat 1 z nasledujuceho
+        else { taking = 0; }
+
+        lhs.numbers[i] = difference;
+    }
+
+    // Odstranenie zbytocnych 0 z konca vektora
+    TrimLimbs(lhs.numbers);
+}
+
+template <class Limbs>
+constexpr void DivisionModuloLogic(BigInteger& lhs, const Limbs& rhs, bool rhs_negative, bool divison) {
+    STATS_SCOPE(divison ? BigOperation::Divide : BigOperation::Modulo, lhs.numbers.size());
+    // Vyber algoritmu (jeden limb / Knuth / Burnikel-Ziegler) podla velkosti, pozri DivideLimbs
+    std::vector<uint64_t> quotient;
+    std::vector<uint64_t> remainder;
+    DivideLimbs(lhs.numbers, rhs, quotient, remainder);
+    lhs.hash_code = 0;
+
+    // Ako pri int: podiel je orezany k 0, zvysok ma znamienko delenca
+    if (divison) {
+        lhs.numbers = std::move(quotient);
+        lhs.negative = !(lhs.negative == rhs_negative);
+    }
+    else {
+        lhs.numbers = std::move(remainder);
+    }
+    // Nastavenie 'zero' pre oba pripady
+    lhs.zero = (lhs.numbers.size() == 1 && lhs.numbers[0] == 0);
+    if (lhs.zero) {
+        lhs.negative = false;
+    }
+
+    return;
+}
+
+constexpr std::pair<BigInteger, BigInteger> divmod(const BigInteger& lhs, const BigInteger& rhs) {  // (lhs / rhs, lhs % rhs) with one division
+    // Ak A/0
+    if (GetZero(rhs)) {
+        throw std::runtime_error("Dividing by 0!");
+    }
+    STATS_SCOPE(BigOperation::Divide, lhs.numbers.size());
+    BigInteger quotient;
+    BigInteger remainder;
+    DivideLimbs(lhs.numbers, rhs.numbers, quotient.numbers, remainder.numbers);
+
+    quotient.zero = (quotient.numbers.size() == 1 && quotient.numbers[0] == 0);
+    quotient.negative = !quotient.zero && (lhs.negative != rhs.negative);
+    remainder.zero = (remainder.numbers.size() == 1 && remainder.numbers[0] == 0);
+    remainder.negative = !remainder.zero && lhs.negative;
+
+    return {std::move(quotient), std::move(remainder)};
+}
+
+constexpr BigInteger EuclidLehmer(BigInteger a, BigInteger b, BigInteger* cofactor) {  // gcd(a, b) for a, b >= 0; *cofactor = s with s*a + t*b = gcd
+    // Invariant: s0 * a_povodne = a, s1 * a_povodne = b (mod b_povodne)
+    BigInteger s0(1);
+    BigInteger s1(0);
+    if (a < b) {
+        std::swap(a, b);
+        std::swap(s0, s1);
+    }
+    while (!b.zero) {
+        const size_t n = a.numbers.size();
+
+        // Lehmer: kroky Euklida na najvyssich dvoch limboch (< 10^18), kym sa kvocienty zhoduju pre obe hranice
+        int64_t A = 1, B = 0, C = 0, D = 1;
+        if (n > 2 && b.numbers.size() == n) {
+            int64_t x = static_cast<int64_t>((a.numbers[n-1] * MODULO) + a.numbers[n-2]);
+            int64_t y = static_cast<int64_t>((b.numbers[n-1] * MODULO) + b.numbers[n-2]);
+            while ((y + C) != 0 && (y + D) != 0) {
+                const int64_t q = (x + A) / (y + C);
+                if (q != (x + B) / (y + D)) {
+                    break;
+                }
+                std::tie(A, C) = std::make_pair(C, A - (q * C));
+                std::tie(B, D) = std::make_pair(D, B - (q * D));
+                std::tie(x, y) = std::make_pair(y, x - (q * y));
+            }
+        }
+
+        // Ziadny krok sa nedal urobit: jedno plne delenie
+        if (B == 0) {
+            auto [quotient, remainder] = divmod(a, b);
+            a = std::move(b);
+            b = std::move(remainder);
+            if (cofactor != nullptr) {
+                quotient *= s1;
+                s0 -= quotient;
+                std::swap(s0, s1);
+            }
+            continue;
+        }
+        // (a, b) = (A a + B b, C a + D b); jeden z dvojice koeficientov je zaporny
+        BigInteger next_a = (BigInteger(A) * a) + (BigInteger(B) * b);
+        BigInteger next_b = (BigInteger(C) * a) + (BigInteger(D) * b);
+        a = std::move(next_a);
+        b = std::move(next_b);
+        if (cofactor != nullptr) {
+            BigInteger next_s0 = (BigInteger(A) * s0) + (BigInteger(B) * s1);
+            BigInteger next_s1 = (BigInteger(C) * s0) + (BigInteger(D) * s1);
+            s0 = std::move(next_s0);
+            s1 = std::move(next_s1);
+        }
+    }
+    if (cofactor != nullptr) {
+        *cofactor = std::move(s0);
+    }
+    return a;
+}
+
+constexpr BigInteger gcd(BigInteger lhs, BigInteger rhs) {  // greatest common divisor, non-negative; gcd(0, 0) = 0
+    if (lhs < 0) { lhs = -lhs; }
+    if (rhs < 0) { rhs = -rhs; }
+    return EuclidLehmer(std::move(lhs), std::move(rhs), nullptr);
+}
+
+constexpr std::tuple<BigInteger, BigInteger, BigInteger> gcdext(const BigInteger& a, const BigInteger& b) {  // (g, s, t) with s*a + t*b = g = gcd(a, b) >= 0
+    // Ak B = 0
+    if (GetZero(b)) {
+        if (GetZero(a)) {
+            return {BigInteger(0), BigInteger(0), BigInteger(0)};
+        }
+        return {GetNegative(a) ? -a : a, BigInteger(GetNegative(a) ? -1 : 1), BigInteger(0)};
+    }
+    BigInteger a_abs = GetNegative(a) ? -a : a;
+    BigInteger b_abs = GetNegative(b) ? -b : b;
+    BigInteger s;
+    BigInteger g = EuclidLehmer(a_abs, b_abs, &s);
+
+    // t = (g - s|a|) / |b| je presne delenie; druhy koeficient sa pocas Euklida nemusel sledovat
+    BigInteger t = g - (s * a_abs);
+    t /= b_abs;
+    if (GetNegative(a)) { s = -s; }
+    if (GetNegative(b)) { t = -t; }
+    return {std::move(g), std::move(s), std::move(t)};
+}
+
+constexpr BigInteger inverse_mod(const BigInteger& a, const BigInteger& modulus) {  // a^(-1) mod modulus in [0, modulus)
+    if (GetNegative(modulus) || GetZero(modulus)) {
+        throw std::runtime_error("Modulus must be positive!");
+    }
+    BigInteger reduced = a % modulus;
+    if (GetNegative(reduced)) {
+        reduced += modulus;
+    }
+    BigInteger s;
+    BigInteger g = EuclidLehmer(std::move(reduced), modulus, &s);
+    if (!IsOne(g) && !IsOne(modulus)) {
+        throw std::runtime_error("No modular inverse!");
+    }
+    s %= modulus;
+    if (GetNegative(s)) {
+        s += modulus;
+    }
+    return s;
+}
+
+constexpr bool EqualVectors(const BigInteger& lhs, const BigInteger& rhs) {
+    return (lhs.numbers == rhs.numbers);
+}
+
+constexpr void SetToZero(BigInteger& biginteger) {
+    biginteger.numbers = {0};
+    biginteger.negative = false;
+    biginteger.zero = true;
+    biginteger.hash_code = 0;
+}
+
+constexpr void SetToOne(BigInteger& biginteger) {
+    biginteger.numbers = {1};
+    biginteger.negative = false;
+    biginteger.zero = false;
+    biginteger.hash_code = 0;
+}
+
+constexpr bool IsOne(const BigInteger& biginteger) {
+    return ((biginteger.numbers.size() == 1) && (biginteger.numbers[0] == 1));
+}
+
+constexpr bool GetNegative(const BigInteger& biginteger) {
+    return biginteger.negative;
+}
+
+constexpr void SetNegative(BigInteger& biginteger, bool value) {
+    biginteger.negative = value;
+}
+
+constexpr bool GetZero(const BigInteger& biginteger) {
+    return biginteger.zero;
+}
+
+inline WideFloat ToWideFloat(const BigInteger& biginteger) {  // |biginteger|, not 0
+    // Najvyssie 4 limby (< 10^36 < 2^120) su presne, zvysne limby iba posunu o MODULO^k
+    const size_t size = biginteger.numbers.size();
+    const size_t top = std::min<size_t>(4, size);
+    WideLimb value = 0;
+    for (size_t i = size; i-- > size - top;) {
+        value = (value * MODULO) + biginteger.numbers[i];
+    }
+    WideFloat result = NormalizeWide(value, 0, true);
+    if (size == top) {
+        return result;
+    }
+    return MultiplyWide(result, PowerOfModulo(size - top));
+}
+
+// random numbers
+template <class URBG>
+BigInteger random_below(const BigInteger& bound, URBG& rng) {  // uniform in <0, bound)
+    // Hranica musi byt kladna
+    if (GetNegative(bound) || GetZero(bound)) {
+        throw std::runtime_error("Random bound must be positive!");
+    }
+    std::uniform_int_distribution<uint64_t> limb_dist(0, MODULO - 1);
+    std::uniform_int_distribution<uint64_t> top_dist(0, bound.numbers.back());
+
+    BigInteger result;
+    result.numbers.resize(bound.numbers.size());
+
+    // Zamietanie: limby sa generuju priamo, najvyssi iba do najvyssieho limbu hranice; Pravdepodobnost prijatia >= 1/2
+    while (true) {
+        result.numbers.back() = top_dist(rng);
+        for (size_t i = 0; i + 1 < result.numbers.size(); i++) {
+            result.numbers[i] = limb_dist(rng);
+        }
+        // Porovnanie s hranicou od najvyssieho limbu
+        bool smaller = false;
+        for (size_t i = result.numbers.size(); i-- > 0;) {
+            if (result.numbers[i] != bound.numbers[i]) {
+                smaller = (result.numbers[i] < bound.numbers[i]);
+                break;
+            }
+        }
+        if (smaller) { break; }
+    }
+
+    // Odstranenie zbytocnych 0 z konca vektora
+    while (result.numbers.size() > 1 && result.numbers.back() == 0) {
+        result.numbers.pop_back();
+    }
+    result.zero = (result.numbers.size() == 1 && result.numbers[0] == 0);
+
+    return result;
+}
+
+template <class URBG>
+BigInteger random_bits(size_t n, URBG& rng) {  // uniform in <0, 2^n)
+    // Ak 0 bitov
+    if (n == 0) {
+        return BigInteger();
+    }
+    // 2^n cez umocnovanie stvorcom, potom vyber pod touto hranicou
+    BigInteger bound(1);
+    BigInteger power(2);
+    while (n > 0) {
+        if (n & 1) {
+            bound *= power;
+        }
+        n >>= 1;
+        if (n > 0) {
+            power *= power;
+        }
+    }
+    return random_below(bound, rng);
+}
+
+// small primes
+#define SMALL_PRIMES_LIMIT 32768
+
+inline std::vector<uint32_t> SievePrimes(uint32_t limit) {  // primes < limit
+    // Eratostenovo sito
+    std::vector<bool> composite(limit, false);
+    std::vector<uint32_t> found;
+    for (uint32_t i = 2; i < limit; i++) {
+        if (composite[i]) { continue; }
+        found.push_back(i);
+        for (uint64_t j = static_cast<uint64_t>(i) * i; j < limit; j += i) {
+            composite[j] = true;
+        }
+    }
+    return found;
+}
+
+inline const std::vector<uint32_t>& SmallPrimes() {
+    // Sito do SMALL_PRIMES_LIMIT, vypocitane iba raz
+    static const std::vector<uint32_t> primes = SievePrimes(SMALL_PRIMES_LIMIT);
+    return primes;
+}
+
+inline const std::vector<uint64_t>& SmallPrimeProducts() {
+    // Sucin skupiny malych prvocisel; Musi platit P * MODULO < 2^64, aby stacil jeden limb zvysku
+    static const std::vector<uint64_t> products = [] {
+        const uint64_t limit = std::numeric_limits<uint64_t>::max() / MODULO;
+        std::vector<uint64_t> found;
+        uint64_t product = 1;
+        for (uint32_t prime : SmallPrimes()) {
+            if (product > limit / prime) {
+                found.push_back(product);
+                product = 1;
+            }
+            product *= prime;
+        }
+        found.push_back(product);
+        return found;
+    }();
+    return products;
+}
+
+inline uint64_t RemainderSmall(const BigInteger& biginteger, uint64_t divisor) {  // Compute |biginteger| % divisor, divisor <= (2^64-1)/MODULO
+    uint64_t rest = 0;
+    // Od najvyssieho limbu: R = (R * MODULO + limb) % divisor
+    for (auto iterator = biginteger.numbers.rbegin(); iterator != biginteger.numbers.rend(); iterator++) {
+        rest = ((rest * MODULO) + *iterator) % divisor;
+    }
+    return rest;
+}
+
+inline std::vector<uint32_t> ToBinaryWords(const BigInteger& biginteger) {  // |biginteger| in base 2^32, little-endian
+    std::vector<uint32_t> words;
+    std::vector<uint64_t> rest = biginteger.numbers;
+    // Opakovane delenie 2^32; Zvysok je dalsie slovo
+    while (!(rest.size() == 1 && rest[0] == 0)) {
+        uint64_t carrying = 0;
+        for (size_t i = rest.size(); i-- > 0;) {
+            uint64_t current = (carrying * MODULO) + rest[i];
+            rest[i] = current >> 32;
+            carrying = current & 0xFFFFFFFFull;
+        }
+        words.push_back(static_cast<uint32_t>(carrying));
+        // Odstranenie zbytocnych 0 z konca vektora
+        while (rest.size() > 1 && rest.back() == 0) {
+            rest.pop_back();
+        }
+    }
+    return words;
+}
+
+inline size_t BitLength(const std::vector<uint32_t>& words) {
+    for (size_t i = words.size(); i-- > 0;) {
+        if (words[i] != 0) {
+            return (i * 32) + (32 - std::countl_zero(words[i]));
+        }
+    }
+    return 0;
+}
+
+inline bool GetBit(const std::vector<uint32_t>& words, size_t index) {
+    return (index / 32 < words.size()) && ((words[index / 32] >> (index % 32)) & 1);
+}
+
+inline std::vector<uint32_t> ShiftRightWords(const std::vector<uint32_t>& words, size_t shift) {
+    std::vector<uint32_t> shifted;
+    size_t word_shift = shift / 32;
+    size_t bit_shift = shift % 32;
+    for (size_t i = word_shift; i < words.size(); i++) {
+        uint64_t value = words[i] >> bit_shift;
+        if (bit_shift && (i + 1) < words.size()) {
+            value |= static_cast<uint64_t>(words[i+1]) << (32 - bit_shift);
+        }
+        shifted.push_back(static_cast<uint32_t>(value));
+    }
+    return shifted;
+}
+
+
+inline size_t WindowSize(size_t bits) {  // sliding window width for an exponent with 'bits' bits
+    if (bits <= 8) { return 1; }
+    if (bits <= 24) { return 2; }
+    if (bits <= 80) { return 3; }
+    if (bits <= 240) { return 4; }
+    if (bits <= 672) { return 5; }
+    return 6;
+}
+
+template <class Element, class Multiply, class Square>
+Element SlidingWindowPow(const Element& base, Element result, const std::vector<uint32_t>& exponent, Multiply multiply, Square square) {  // base^exponent, 'result' is 1; multiply(acc, x), square(acc) in place
+    const size_t bits = BitLength(exponent);
+    if (bits == 0) {
+        return result;
+    }
+    const size_t window = WindowSize(bits);
+
+    // Neparne mocniny: table[k] = base^(2k+1)
+    std::vector<Element> table(static_cast<size_t>(1) << (window - 1), base);
+    if (table.size() > 1) {
+        Element squared = base;
+        square(squared);
+        for (size_t k = 1; k < table.size(); k++) {
+            table[k] = table[k-1];
+            multiply(table[k], squared);
+        }
+    }
+
+    // Zlava doprava: nulovy bit = umocnenie na druhu, inak okno najviac 'window' bitov koncace jednotkou
+    bool first = true;
+    for (size_t i = bits; i-- > 0;) {
+        if (!GetBit(exponent, i)) {
+            square(result);
+            continue;
+        }
+        size_t low = (i + 1 >= window) ? (i + 1 - window) : 0;
+        while (!GetBit(exponent, low)) {
+            low++;
+        }
+        size_t value = 0;
+        for (size_t j = i + 1; j-- > low;) {
+            value = (value << 1) | GetBit(exponent, j);
+        }
+        // Prve okno: result je este 1, staci ho nahradit
+        if (first) {
+            multiply(result, table[value >> 1]);
+        }
+        else {
+            for (size_t j = low; j <= i; j++) {
+                square(result);
+            }
+            multiply(result, table[value >> 1]);
+        }
+        first = false;
+        i = low;
+    }
+    return result;
+}
+
+// montgomery arithmetic in base MODULO
+class MontgomeryContext
+{
+public:
+    using Residue = std::vector<uint64_t>;
+
+    // constructors
+    MontgomeryContext()
+        : modulus()
+        , inverse(0)
+        , r_squared()
+        , scratch()
+    {}
+
+    explicit MontgomeryContext(const BigInteger& modulus)
+        : MontgomeryContext()
+    {
+        this->reset(modulus);
+    }
+
+    void reset(const BigInteger& modulus) {  // switch to another modulus, buffers are reused
+        // R = MODULO^n musi byt nesudelitelne s N, cize N nesmie byt delitelne 2 ani 5
+        if (GetNegative(modulus) || GetZero(modulus) || IsOne(modulus) || (modulus.numbers[0] % 2 == 0) || (modulus.numbers[0] % 5 == 0)) {
+            throw std::runtime_error("Montgomery modulus must be > 1 and coprime to 10!");
+        }
+        this->modulus = modulus;
+        size_t n = this->modulus.numbers.size();
+
+        // -N^(-1) mod MODULO
+        this->inverse = (MODULO - InverseModBase(this->modulus.numbers[0])) % MODULO;
+
+        // R^2 mod N; Jedine velke delenie pre cely kontext
+        BigInteger r2;
+        r2.numbers.assign((2 * n) + 1, 0);
+        r2.numbers.back() = 1;
+        r2.zero = false;
+        r2 %= this->modulus;
+        this->r_squared = Pad(r2.numbers);
+
+        this->scratch.assign(n + 2, 0);
+    }
+
+    size_t size() const {
+        return this->modulus.numbers.size();
+    }
+
+    const BigInteger& get_modulus() const {
+        return this->modulus;
+    }
+
+    // conversion
+    Residue to_montgomery(const BigInteger& biginteger) const {
+        // Najprv redukcia do intervalu <0, N)
+        BigInteger reduced = biginteger;
+        if (GetNegative(reduced) || reduced >= this->modulus) {
+            reduced %= this->modulus;
+            if (GetNegative(reduced)) {
+                reduced += this->modulus;
+            }
+        }
+        Residue converted;
+        this->multiply(Pad(reduced.numbers), this->r_squared, converted);
+        return converted;
+    }
+
+    BigInteger from_montgomery(const Residue& residue) const {
+        Residue unit(this->size(), 0);
+        unit[0] = 1;
+        Residue converted;
+        this->multiply(residue, unit, converted);
+
+        BigInteger result;
+        result.numbers = std::move(converted);
+        // Odstranenie zbytocnych 0 z konca vektora
+        while (result.numbers.size() > 1 && result.numbers.back() == 0) {
+            result.numbers.pop_back();
+        }
+        result.zero = (result.numbers.size() == 1 && result.numbers[0] == 0);
+        return result;
+    }
+
+    Residue one() const {
+        return this->to_montgomery(BigInteger(1));
+    }
+
+    static bool is_zero(const Residue& residue) {
+        for (uint64_t limb : residue) {
+            if (limb != 0) { return false; }
+        }
+        return true;
+    }
+
+    // arithmetics
+    void multiply(const Residue& a, const Residue& b, Residue& out) const {  // Compute a*b*R^(-1) % N
+        const size_t n = this->size();
+        const uint64_t* mod = this->modulus.numbers.data();
+        uint64_t* t = this->scratch.data();
+        std::fill(this->scratch.begin(), this->scratch.end(), 0);
+
+        // CIOS: po kazdom riadku sucinu sa hned redukuje jeden limb
+        for (size_t i = 0; i < n; i++) {
+            CANCEL_POINT(i);
+            uint64_t carrying = 0;
+            const uint64_t bi = b[i];
+            for (size_t j = 0; j < n; j++) {
+                uint64_t total = t[j] + (a[j] * bi) + carrying;
+                t[j] = total % MODULO;
+                carrying = total / MODULO;
+            }
+            uint64_t total = t[n] + carrying;
+            t[n] = total % MODULO;
+            t[n+1] = total / MODULO;
+
+            // m = t[0] * (-N^(-1)) mod MODULO; t + m*N je delitelne MODULO
+            const uint64_t m = (t[0] * this->inverse) % MODULO;
+            carrying = (t[0] + (m * mod[0])) / MODULO;
+            for (size_t j = 1; j < n; j++) {
+                total = t[j] + (m * mod[j]) + carrying;
+                t[j-1] = total % MODULO;
+                carrying = total / MODULO;
+            }
+            total = t[n] + carrying;
+            t[n-1] = total % MODULO;
+            t[n] = t[n+1] + (total / MODULO);
+        }
+
+        // Vysledok je < 2N, staci jedno odcitanie
+        if (t[n] != 0 || !LessThanModulus(t)) {
+            SubtractModulus(t, n + 1);
+        }
+        out.assign(t, t + n);
+    }
+
+    Residue multiply(const Residue& a, const Residue& b) const {
+        Residue out;
+        this->multiply(a, b, out);
+        return out;
+    }
+
+    Residue add(const Residue& a, const Residue& b) const {  // Compute (a+b) % N
+        const size_t n = this->size();
+        Residue sum(n + 1, 0);
+        uint64_t carrying = 0;
+        for (size_t i = 0; i < n; i++) {
+            carrying += a[i] + b[i];
+            sum[i] = carrying % MODULO;
+            carrying /= MODULO;
+        }
+        sum[n] = carrying;
+        if (sum[n] != 0 || !LessThanModulus(sum.data())) {
+            SubtractModulus(sum.data(), n + 1);
+        }
+        sum.pop_back();
+        return sum;
+    }
+
+    Residue subtract(const Residue& a, const Residue& b) const {  // Compute (a-b) % N
+        const size_t n = this->size();
+        Residue difference(n, 0);
+        int64_t taking = 0;
+        for (size_t i = 0; i < n; i++) {
+            int64_t value = static_cast<int64_t>(a[i]) - static_cast<int64_t>(b[i]) - taking;
+            taking = (value < 0);
+            difference[i] = (value < 0) ? (value + MODULO) : value;
+        }
+        // Zaporny vysledok; Pripocitanie N
+        if (taking) {
+            uint64_t carrying = 0;
+            for (size_t i = 0; i < n; i++) {
+                carrying += difference[i] + this->modulus.numbers[i];
+                difference[i] = carrying % MODULO;
+                carrying /= MODULO;
+            }
+        }
+        return difference;
+    }
+
+    Residue half(const Residue& a) const {  // Compute a/2 % N
+        const size_t n = this->size();
+        Residue value(a);
+        value.push_back(0);
+        // Neparne cislo; Pripocitanie N (N je neparne), aby bolo delitelne 2
+        if (value[0] % 2 == 1) {
+            uint64_t carrying = 0;
+            for (size_t i = 0; i < n; i++) {
+                carrying += value[i] + this->modulus.numbers[i];
+                value[i] = carrying % MODULO;
+                carrying /= MODULO;
+            }
+            value[n] = carrying;
+        }
+        uint64_t rest = 0;
+        for (size_t i = n + 1; i-- > 0;) {
+            uint64_t current = (rest * MODULO) + value[i];
+            value[i] = current / 2;
+            rest = current % 2;
+        }
+        value.pop_back();
+        return value;
+    }
+
+    Residue pow(const Residue& base, const std::vector<uint32_t>& exponent) const {  // Compute base^exponent, exponent in base 2^32
+        STATS_SCOPE(BigOperation::ModPow, this->size());
+        return SlidingWindowPow(base, this->one(), exponent,
+            [this](Residue& accumulator, const Residue& factor) { this->multiply(accumulator, factor, accumulator); },
+            [this](Residue& accumulator) { this->multiply(accumulator, accumulator, accumulator); });
+    }
+
+private:
+    BigInteger modulus;
+    uint64_t inverse;
+    Residue r_squared;
+    mutable std::vector<uint64_t> scratch;
+
+    static uint64_t InverseModBase(uint64_t value) {  // Compute value^(-1) % MODULO
+        // Rozsireny Euklidov algoritmus
+        int64_t old_r = value, r = MODULO;
+        int64_t old_s = 1, s = 0;
+        while (r != 0) {
+            int64_t quotient = old_r / r;
+            std::tie(old_r, r) = std::make_pair(r, old_r - (quotient * r));
+            std::tie(old_s, s) = std::make_pair(s, old_s - (quotient * s));
+        }
+        return (old_s < 0) ? static_cast<uint64_t>(old_s + MODULO) : static_cast<uint64_t>(old_s);
+    }
+
+    Residue Pad(const std::vector<uint64_t>& limbs) const {
+        Residue padded(limbs);
+        padded.resize(this->size(), 0);
+        return padded;
+    }
+
+    bool LessThanModulus(const uint64_t* limbs) const {
+        for (size_t i = this->size(); i-- > 0;) {
+            if (limbs[i] != this->modulus.numbers[i]) {
+                return (limbs[i] < this->modulus.numbers[i]);
+            }
+        }
+        return false;
+    }
+
+    void SubtractModulus(uint64_t* limbs, size_t length) const {
+        int64_t taking = 0;
+        for (size_t i = 0; i < length; i++) {
+            int64_t value = static_cast<int64_t>(limbs[i]) - taking;
+            if (i < this->size()) {
+                value -= static_cast<int64_t>(this->modulus.numbers[i]);
+            }
+            taking = (value < 0);
+            limbs[i] = (value < 0) ? (value + MODULO) : value;
+        }
+    }
+};
+
+
+// exponentiation
+inline BigInteger PowWords(const BigInteger& base, const std::vector<uint32_t>& exponent) {  // base^exponent, exponent in base 2^32
+    // Ak A^0 alebo 0^B
+    if (BitLength(exponent) == 0) {
+        return BigInteger(1);
+    }
+    if (GetZero(base)) {
+        return base;
+    }
+    // Ak (+-1)^B; Znamienko podla parity exponentu
+    if (IsOne(base)) {
+        return (GetNegative(base) && GetBit(exponent, 0)) ? base : BigInteger(1);
+    }
+
+    STATS_SCOPE(BigOperation::Pow, base.numbers.size());
+    // Umocnenie na druhu cez 'acc *= acc' pouzije SquareLimbs
+    return SlidingWindowPow(base, BigInteger(1), exponent,
+        [](BigInteger& accumulator, const BigInteger& factor) { accumulator *= factor; },
+        [](BigInteger& accumulator) { accumulator *= accumulator; });
+}
+
+inline BigInteger pow(const BigInteger& base, uint64_t exponent) {  // base^exponent
+    return PowWords(base, {static_cast<uint32_t>(exponent), static_cast<uint32_t>(exponent >> 32)});
+}
+
+inline BigInteger pow(const BigInteger& base, const BigInteger& exponent) {  // base^exponent, exponent >= 0
+    if (GetNegative(exponent)) {
+        throw std::runtime_error("Negative exponent!");
+    }
+    return PowWords(base, ToBinaryWords(exponent));
+}
+
+inline BigInteger pow_mod(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus) {  // base^exponent % modulus in [0, modulus), exponent >= 0
+    if (GetNegative(modulus) || GetZero(modulus)) {
+        throw std::runtime_error("Modulus must be positive!");
+    }
+    if (GetNegative(exponent)) {
+        throw std::runtime_error("Negative exponent!");
+    }
+    // Ak A^B % 1
+    if (IsOne(modulus)) {
+        return BigInteger(0);
+    }
+
+    // Zaklad do intervalu <0, N)
+    BigInteger reduced = base % modulus;
+    if (GetNegative(reduced)) {
+        reduced += modulus;
+    }
+
+    // Maly modul nesudelitelny s 10: Montgomery (bez delenia), inak redukcia cez % (Karatsuba + Burnikel-Ziegler) po kazdom nasobeni
+    if (modulus.numbers.size() < BIGNUMBER_MONTGOMERY_THRESHOLD && RemainderSmall(modulus, 2) != 0 && RemainderSmall(modulus, 5) != 0) {
+        MontgomeryContext context(modulus);
+        return context.from_montgomery(context.pow(context.to_montgomery(reduced), ToBinaryWords(exponent)));
+    }
+    STATS_SCOPE(BigOperation::ModPow, modulus.numbers.size());
+    return SlidingWindowPow(reduced, BigInteger(1), ToBinaryWords(exponent),
+        [&modulus](BigInteger& accumulator, const BigInteger& factor) { accumulator *= factor; accumulator %= modulus; },
+        [&modulus](BigInteger& accumulator) { accumulator *= accumulator; accumulator %= modulus; });
+}
+
+class FixedBasePow  // base^exponent % modulus for a reused base; table of base^(d * 2^(window*i)) makes every call squaring-free
+{
+public:
+    // constructors
+    FixedBasePow(const BigInteger& base, const BigInteger& modulus, size_t max_bits, size_t window = 4)
+        : base(base)
+        , modulus(modulus)
+        , window(window)
+        , windows((max_bits + window - 1) / window)
+        , montgomery(false)
+    {
+        if (GetNegative(modulus) || GetZero(modulus)) {
+            throw std::runtime_error("Modulus must be positive!");
+        }
+        if (window == 0 || window > 8) {
+            throw std::runtime_error("Window must be 1..8 bits!");
+        }
+        BigInteger reduced = base % modulus;
+        if (GetNegative(reduced)) {
+            reduced += modulus;
+        }
+
+        // Rovnaka volba ako v pow_mod
+        this->montgomery = !IsOne(modulus) && modulus.numbers.size() < BIGNUMBER_MONTGOMERY_THRESHOLD && RemainderSmall(modulus, 2) != 0 && RemainderSmall(modulus, 5) != 0;
+        if (this->montgomery) {
+            this->context.reset(modulus);
+            this->build(this->residues, this->context.to_montgomery(reduced));
+        }
+        else {
+            this->build(this->values, reduced);
+        }
+    }
+
+    size_t max_bits() const {
+        return this->windows * this->window;
+    }
+
+    BigInteger pow(const BigInteger& exponent) const {  // not thread-safe (shares the context's scratch)
+        if (GetNegative(exponent)) {
+            throw std::runtime_error("Negative exponent!");
+        }
+        const std::vector<uint32_t> bits = ToBinaryWords(exponent);
+        // Dlhsi exponent ako tabulka
+        if (BitLength(bits) > this->max_bits()) {
+            return pow_mod(this->base, exponent, this->modulus);
+        }
+        STATS_SCOPE(BigOperation::ModPow, this->modulus.numbers.size());
+        if (this->montgomery) {
+            return this->context.from_montgomery(this->evaluate(this->residues, this->context.one(), bits));
+        }
+        return this->evaluate(this->values, BigInteger(1) % this->modulus, bits);
+    }
+
+private:
+    void multiply(MontgomeryContext::Residue& accumulator, const MontgomeryContext::Residue& factor) const {
+        this->context.multiply(accumulator, factor, accumulator);
+    }
+
+    void multiply(BigInteger& accumulator, const BigInteger& factor) const {
+        accumulator *= factor;
+        accumulator %= this->modulus;
+    }
+
+    template <class Element>
+    void build(std::vector<Element>& table, Element power) {
+        // table[i*(2^window - 1) + d - 1] = power_i^d, kde power_i = base^(2^(window*i))
+        const size_t digits = static_cast<size_t>(1) << this->window;
+        table.reserve(this->windows * (digits - 1));
+        for (size_t i = 0; i < this->windows; i++) {
+            table.push_back(power);
+            for (size_t d = 2; d < digits; d++) {
+                Element next = table.back();
+                this->multiply(next, power);
+                table.push_back(std::move(next));
+            }
+            // power_(i+1) = power_i^(2^window)
+            if (i + 1 < this->windows) {
+                this->multiply(power, table.back());
+            }
+        }
+    }
+
+    template <class Element>
+    Element evaluate(const std::vector<Element>& table, Element result, const std::vector<uint32_t>& exponent) const {
+        // Iba jedno nasobenie za kazde nenulove okno exponentu
+        const size_t digits = static_cast<size_t>(1) << this->window;
+        for (size_t i = 0; i < this->windows; i++) {
+            size_t digit = 0;
+            for (size_t j = this->window; j-- > 0;) {
+                digit = (digit << 1) | GetBit(exponent, (i * this->window) + j);
+            }
+            if (digit != 0) {
+                this->multiply(result, table[(i * (digits - 1)) + digit - 1]);
+            }
+        }
+        return result;
+    }
+
+    BigInteger base;
+    BigInteger modulus;
+    size_t window;
+    size_t windows;
+    bool montgomery;
+    MontgomeryContext context;
+    std::vector<MontgomeryContext::Residue> residues;
+    std::vector<BigInteger> values;
+};
+
+
+// floating point conversion
+inline std::pair<uint64_t, int64_t> RoundToDouble(const BigInteger& value, int64_t min_exponent) {  // |value| ~ significand * 2^exponent, value != 0
+    const WideFloat wide = ToWideFloat(value);
+    if (auto rounded = RoundWide(wide, min_exponent)) {
+        return *rounded;
+    }
+    // Hranica zaokruhlenia v intervale chyby: presny podiel s ~72 bitmi, zvysok ako sticky bit
+    const int64_t shift = wide.exponent + 128 - 72;
+    auto [quotient, remainder] = divmod(value, pow(BigInteger(2), static_cast<uint64_t>(shift)));
+    quotient *= 2;
+    quotient += GetZero(remainder) ? 0 : (GetNegative(value) ? -1 : 1);
+    WideFloat exact = ToWideFloat(quotient);
+    exact.exponent += shift - 1;
+    return *RoundWide(exact, min_exponent);
+}
+
+inline std::pair<double, int64_t> frexp(const BigInteger& biginteger) {  // (mantissa, exponent), |mantissa| in <0.5, 1) rounded to 53 bits, value ~ mantissa * 2^exponent
+    if (GetZero(biginteger)) {
+        return {0.0, 0};
+    }
+    auto [significand, exponent] = RoundToDouble(biginteger, std::numeric_limits<int64_t>::min() / 2);
+    const double mantissa = std::ldexp(static_cast<double>(significand), -53);
+    return {GetNegative(biginteger) ? -mantissa : mantissa, exponent + 53};
+}
+
+#if SUPPORT_MORE_OPS == 1
+inline BigInteger BigInteger::isqrt() const {
+    // Ak zaporne cislo
+    if (this->negative) {
+        throw std::runtime_error("No SQRT of negative BigInteger");
+    }
+    // Ak 0 alebo 1
+    if (this->zero || IsOne(*this)) {
+        return *this;
+    }
+
+    STATS_SCOPE(BigOperation::IntegerSqrt, this->numbers.size());
+    // Odhad z frexp ma ~50 spravnych bitov a je >= sqrt; kazdy Newtonov krok zdvojnasobi presnost
+    auto [mantissa, exponent] = frexp(*this);
+    if (exponent & 1) {
+        mantissa *= 2;
+        exponent--;
+    }
+    const int64_t half = exponent / 2;
+    BigInteger guess;
+    if (half <= 52) {
+        guess = BigInteger(static_cast<int64_t>(std::ldexp(std::sqrt(mantissa), static_cast<int>(half))) + 2);
+    }
+    else {
+        guess = BigInteger(static_cast<int64_t>(std::ldexp(std::sqrt(mantissa), 53)) + 2);
+        guess *= pow(BigInteger(2), static_cast<uint64_t>(half - 53));
+    }
+
+    // Newton: postupnost klesa, kym nedosiahne floor(sqrt)
+    while (true) {
+        BigInteger value = guess + (*this / guess);
+        value /= 2;
+        if (value >= guess) {
+            return guess;
+        }
+        guess = std::move(value);
+    }
+}
+#endif
+
+inline double BigInteger::to_double() const {
+    if (this->zero) {
+        return 0.0;
+    }
+    auto [significand, exponent] = RoundToDouble(*this, std::numeric_limits<double>::min_exponent - std::numeric_limits<double>::digits);
+    if (exponent + 53 > std::numeric_limits<double>::max_exponent) {
+        throw std::runtime_error("BigInteger too big!");
+    }
+    const double converted = std::ldexp(static_cast<double>(significand), static_cast<int>(exponent));
+    return this->negative ? -converted : converted;
+}
+
+
+// radix conversion: base 10 maps directly onto the limbs; other bases go through chunks of base^m < MODULO,
+// split (or joined) by precomputed powers chunk^(2^i), so the cost follows the multiply and divide kernels
+#define RADIX_NAIVE_LIMBS 32
+#define RADIX_DIGITS "0123456789abcdefghijklmnopqrstuvwxyz"
+
+constexpr int RadixDigit(int c) {  // value of digit character c, 36 if not a digit in any base
+    if (c >= '0' && c <= '9') { return c - '0'; }
+    if (c >= 'a' && c <= 'z') { return (c - 'a') + 10; }
+    if (c >= 'A' && c <= 'Z') { return (c - 'A') + 10; }
+    return 36;
+}
+
+inline std::pair<uint64_t, size_t> RadixChunk(uint64_t base) {  // (base^m, m) for the largest m with base^m < MODULO
+    uint64_t chunk = base;
+    size_t digits = 1;
+    while (chunk * base < MODULO) {
+        chunk *= base;
+        digits++;
+    }
+    return {chunk, digits};
+}
+
+inline void ToRadixChunks(const BigInteger& value, const std::vector<BigInteger>& powers, size_t level, uint64_t chunk, uint64_t* out) {  // value >= 0, value < chunk^(2^level); out[2^level] (zeroed) = chunks, little-endian
+    // Male cislo: opakovane delenie jednym chunkom
+    if (level == 0 || value.numbers.size() <= RADIX_NAIVE_LIMBS) {
+        std::vector<uint64_t> limbs = value.numbers;
+        for (size_t i = 0; !(limbs.size() == 1 && limbs[0] == 0); i++) {
+            out[i] = DivideSmallLimbs(limbs, chunk);
+        }
+        return;
+    }
+    // value = high * chunk^(2^(level-1)) + low; obe polovice su mensie nez delitel
+    auto [high, low] = divmod(value, powers[level - 1]);
+    ToRadixChunks(low, powers, level - 1, chunk, out);
+    ToRadixChunks(high, powers, level - 1, chunk, out + (size_t{1} << (level - 1)));
+}
+
+inline BigInteger FromRadixChunks(const std::vector<uint64_t>& chunks, uint64_t chunk) {  // sum chunks[i] * chunk^i, chunks not empty
+    // Listy: skupiny RADIX_NAIVE_LIMBS chunkov Hornerovou schemou priamo v limboch
+    std::vector<BigInteger> values;
+    values.reserve((chunks.size() + RADIX_NAIVE_LIMBS - 1) / RADIX_NAIVE_LIMBS);
+    for (size_t from = 0; from < chunks.size(); from += RADIX_NAIVE_LIMBS) {
+        const size_t to = std::min<size_t>(from + RADIX_NAIVE_LIMBS, chunks.size());
+        BigInteger value;
+        value.numbers = {0};
+        for (size_t i = to; i-- > from;) {
+            uint64_t carrying = chunks[i];
+            for (uint64_t& limb : value.numbers) {
+                uint64_t total = (limb * chunk) + carrying;
+                limb = total % MODULO;
+                carrying = total / MODULO;
+            }
+            if (carrying > 0) {
+                value.numbers.push_back(carrying);
+            }
+        }
+        TrimLimbs(value.numbers);
+        value.zero = (value.numbers.size() == 1 && value.numbers[0] == 0);
+        values.push_back(std::move(value));
+    }
+
+    // Spajanie po dvojiciach: lavy + pravy * chunk^(RADIX_NAIVE_LIMBS * 2^i)
+    BigInteger power = pow(BigInteger(static_cast<int64_t>(chunk)), RADIX_NAIVE_LIMBS);
+    while (values.size() > 1) {
+        std::vector<BigInteger> next;
+        next.reserve((values.size() + 1) / 2);
+        for (size_t i = 0; i < values.size(); i += 2) {
+            if (i + 1 < values.size()) {
+                BigInteger combined = values[i + 1] * power;
+                combined += values[i];
+                next.push_back(std::move(combined));
+            }
+            else {
+                next.push_back(std::move(values[i]));
+            }
+        }
+        values = std::move(next);
+        if (values.size() > 1) {
+            power *= power;
+        }
+    }
+    return std::move(values[0]);
+}
+
+inline std::string BigInteger::to_string(int base) const {
+    if (base < 2 || base > 36) {
+        throw std::runtime_error("Base must be between 2 and 36!");
+    }
+    if (this->zero) {
+        return "0";
+    }
+
+    std::string text;
+    if (base == 10) {
+        // Najvyssi limb bez prefixovych 0-ul, ostatne doplnene na DIGITS cifier
+        text.reserve((this->numbers.size() * DIGITS) + 1);
+        text += std::to_string(this->numbers.back());
+        for (size_t i = this->numbers.size() - 1; i-- > 0;) {
+            CANCEL_POINT(i);
+            const std::string part = std::to_string(this->numbers[i]);
+            text.append(DIGITS - part.size(), '0');
+            text += part;
+        }
+    }
+    else {
+        const auto [chunk, width] = RadixChunk(static_cast<uint64_t>(base));
+        const BigInteger magnitude = this->negative ? -*this : *this;
+
+        // chunk^(2^i), kym stvorec posledneho nemoze byt mensi nez cislo
+        std::vector<BigInteger> powers{BigInteger(static_cast<int64_t>(chunk))};
+        while (2 * (powers.back().numbers.size() - 1) < magnitude.numbers.size()) {
+            powers.push_back(powers.back() * powers.back());
+        }
+        std::vector<uint64_t> chunks(size_t{1} << powers.size(), 0);
+        ToRadixChunks(magnitude, powers, powers.size(), chunk, chunks.data());
+        size_t count = chunks.size();
+        while (count > 1 && chunks[count - 1] == 0) {
+            count--;
+        }
+
+        // Kazdy chunk ma presne 'width' cifier; Mocniny 2 cez posun a masku
+        const bool binary = std::has_single_bit(static_cast<unsigned>(base));
+        const int shift = std::countr_zero(static_cast<unsigned>(base));
+        text.assign(count * width, '0');
+        for (size_t i = 0; i < count; i++) {
+            uint64_t part = chunks[i];
+            const size_t end = text.size() - (i * width);
+            for (size_t d = 0; d < width && part > 0; d++) {
+                text[end - 1 - d] = RADIX_DIGITS[binary ? (part & (base - 1)) : (part % base)];
+                part = binary ? (part >> shift) : (part / base);
+            }
+        }
+        text.erase(0, text.find_first_not_of('0'));
+    }
+    if (this->negative) {
+        text.insert(text.begin(), '-');
+    }
+    return text;
+}
+
+inline BigInteger BigInteger::from_string(const std::string& str, int base) {
+    if (base < 2 || base > 36) {
+        throw std::runtime_error("Base must be between 2 and 36!");
+    }
+    if (base == 10) {
+        return BigInteger(str);
+    }
+    if (str.empty()) {
+        throw std::runtime_error("Empty BigInteger!");
+    }
+    size_t position = (str[0] == '+' || str[0] == '-') ? 1 : 0;
+    if (position == str.size()) {
+        throw std::runtime_error("No digit(s) in BigInteger!");
+    }
+    for (size_t i = position; i < str.size(); i++) {
+        if (RadixDigit(static_cast<unsigned char>(str[i])) >= base) {
+            throw std::runtime_error("Invalid digit for base!");
+        }
+    }
+
+    // Chunky po 'width' cifrach od konca retazca
+    const auto [chunk, width] = RadixChunk(static_cast<uint64_t>(base));
+    std::vector<uint64_t> chunks;
+    chunks.reserve(((str.size() - position) + width - 1) / width);
+    for (size_t end = str.size(); end > position; end -= std::min(end - position, width)) {
+        const size_t start = (end - position > width) ? (end - width) : position;
+        uint64_t part = 0;
+        for (size_t j = start; j < end; j++) {
+            part = (part * base) + RadixDigit(static_cast<unsigned char>(str[j]));
+        }
+        chunks.push_back(part);
+    }
+
+    BigInteger result = FromRadixChunks(chunks, chunk);
+    if (str[0] == '-' && !result.zero) {
+        result.negative = true;
+    }
+    return result;
+}
+
+
+// products: balanced product trees, so the multiply kernels get operands of similar size
+#define PRODUCT_PARALLEL_LEAVES 64
+#define BINOMIAL_SIEVE_LIMIT (1 << 26)
+
+template <class Leaf, class Combine>
+auto BinarySplit(size_t from, size_t to, size_t threads, const Leaf& leaf, const Combine& combine) -> decltype(leaf(from)) {  // combine(left, right) over a balanced tree of leaf(i), from < to
+    if (to - from == 1) {
+        return leaf(from);
+    }
+    const size_t middle = from + ((to - from) / 2);
+
+    // Lava polovica stromu v novom vlakne, prava v aktualnom
+    if (threads > 1 && (to - from) >= PRODUCT_PARALLEL_LEAVES) {
+        std::optional<decltype(leaf(from))> left;
+        std::exception_ptr error;
+        std::thread worker([&] {
+            try {
+                left = BinarySplit(from, middle, threads / 2, leaf, combine);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+        });
+        auto right = BinarySplit(middle, to, threads - (threads / 2), leaf, combine);
+        worker.join();
+        if (error) { std::rethrow_exception(error); }
+        return combine(std::move(*left), std::move(right));
+    }
+    auto left = BinarySplit(from, middle, 1, leaf, combine);
+    return combine(std::move(left), BinarySplit(middle, to, 1, leaf, combine));
+}
+
+inline BigInteger ProductTree(std::vector<BigInteger>& values, size_t from, size_t to, size_t threads) {  // product of values[from, to), values are consumed
+    if (from == to) {
+        return BigInteger(1);
+    }
+    return BinarySplit(from, to, threads,
+        [&values](size_t i) { return std::move(values[i]); },
+        [](BigInteger left, const BigInteger& right) { left *= right; return left; });
+}
+
+inline BigInteger FromUInt64(uint64_t value) {  // BigInteger(int64_t) covers only values < 2^63
+    BigInteger result(static_cast<int64_t>(value / MODULO));
+    result *= BigInteger(MODULO);
+    result += BigInteger(static_cast<int64_t>(value % MODULO));
+    return result;
+}
+
+struct LeafPacker  // consecutive small factors (< 2^63) multiplied into product tree leaves < 2^63; larger factors are leaves of their own
+{
+    void push(uint64_t factor) {
+        if (factor > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            this->leaves.push_back(FromUInt64(factor));
+            return;
+        }
+        if (this->packed > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) / factor) {
+            this->leaves.emplace_back(static_cast<int64_t>(this->packed));
+            this->packed = 1;
+        }
+        this->packed *= factor;
+    }
+
+    BigInteger product(size_t threads) {
+        this->leaves.emplace_back(static_cast<int64_t>(this->packed));
+        this->packed = 1;
+        return ProductTree(this->leaves, 0, this->leaves.size(), threads);
+    }
+
+    std::vector<BigInteger> leaves;
+    uint64_t packed = 1;
+};
+
+template <std::ranges::input_range Range>
+BigInteger product(const Range& range, size_t threads = 1) {  // product of all elements (convertible to BigInteger), 1 for an empty range
+    std::vector<BigInteger> values;
+    if constexpr (std::ranges::sized_range<Range>) {
+        values.reserve(std::ranges::size(range));
+    }
+    for (const auto& value : range) {
+        values.emplace_back(value);
+    }
+    return ProductTree(values, 0, values.size(), threads);
+}
+
+inline BigInteger factorial(uint64_t n, size_t threads = 1) {  // n!
+    LeafPacker packer;
+    for (uint64_t i = 2; i <= n; i++) {
+        packer.push(i);
+    }
+    return packer.product(threads);
+}
+
+inline BigInteger primorial(uint64_t n, size_t threads = 1) {  // product of all primes <= n
+    if (n > std::numeric_limits<uint32_t>::max() - 1) {
+        throw std::runtime_error("Primorial argument too large!");
+    }
+    LeafPacker packer;
+    for (uint32_t prime : SievePrimes(static_cast<uint32_t>(n) + 1)) {
+        packer.push(prime);
+    }
+    return packer.product(threads);
+}
+
+inline BigInteger binomial(uint64_t n, uint64_t k, size_t threads = 1) {  // n choose k, 0 when k > n
+    if (k > n) {
+        return BigInteger(0);
+    }
+    k = std::min(k, n - k);
+    if (k == 0) {
+        return BigInteger(1);
+    }
+
+    LeafPacker packer;
+    // Velke k voci n: rozklad na prvocisla (Legendre), exponent p je sum(n/p^i - k/p^i - (n-k)/p^i); Bez delenia
+    if (n <= BINOMIAL_SIEVE_LIMIT && (16 * k) >= n) {
+        for (uint32_t prime : SievePrimes(static_cast<uint32_t>(n) + 1)) {
+            for (uint64_t power = prime; power <= n; power *= prime) {
+                for (uint64_t i = (n / power) - (k / power) - ((n - k) / power); i > 0; i--) {
+                    packer.push(prime);
+                }
+            }
+        }
+        return packer.product(threads);
+    }
+
+    // Inak (n-k+1)...n / k!; Delenie je presne (zhora, aby i++ nepretieklo pri n = 2^64-1)
+    for (uint64_t i = 0; i < k; i++) {
+        packer.push(n - i);
+    }
+    return packer.product(threads) / factorial(k, threads);
+}
+
+
+// accumulator: limbs absorb additions without carrying; carries are propagated only every ACCUMULATOR_PENDING_LIMIT additions
+#define ACCUMULATOR_PENDING_LIMIT (static_cast<uint64_t>(1) << 33)
+
+class BigAccumulator  // sum of many BigIntegers; positive and negative terms are kept apart, no sign redirects
+{
+public:
+    // constructors
+    BigAccumulator()
+        : positive()
+        , negative()
+        , pending(0)
+    {}
+
+    void add(const BigInteger& value) {
+        if (value.zero) { return; }
+        this->accumulate(value.negative ? this->negative : this->positive, value.numbers);
+    }
+
+    void sub(const BigInteger& value) {
+        if (value.zero) { return; }
+        this->accumulate(value.negative ? this->positive : this->negative, value.numbers);
+    }
+
+    void addmul(const BigInteger& value, uint32_t factor) {  // += value * factor
+        if (value.zero || factor == 0) { return; }
+        std::vector<uint64_t>& sum = value.negative ? this->negative : this->positive;
+        this->reserve(sum, value.numbers.size() + 2);
+
+        // Sucin s prenosom, pripocitany bez prenosu; Limb sumy narastie o menej ako MODULO
+        uint64_t carrying = 0;
+        size_t i = 0;
+        for (; i < value.numbers.size(); i++) {
+            carrying += value.numbers[i] * factor;
+            sum[i] += carrying % MODULO;
+            carrying /= MODULO;
+        }
+        for (; carrying > 0; i++) {
+            sum[i] += carrying % MODULO;
+            carrying /= MODULO;
+        }
+        this->settle();
+    }
+
+    void merge(const BigAccumulator& other) {  // adds another (e.g. thread-local) accumulator
+        this->pending += other.pending;
+        for (auto [sum, source] : {std::pair{&this->positive, &other.positive}, std::pair{&this->negative, &other.negative}}) {
+            this->reserve(*sum, source->size());
+            for (size_t i = 0; i < source->size(); i++) {
+                (*sum)[i] += (*source)[i];
+            }
+        }
+        this->settle();
+    }
+
+    BigInteger value() const {
+        std::vector<uint64_t> plus = this->positive;
+        std::vector<uint64_t> minus = this->negative;
+        Normalize(plus);
+        Normalize(minus);
+
+        // Vysledok = plus - minus
+        BigInteger result;
+        const int comparison = CompareLimbs(plus, minus);
+        if (comparison == 0) {
+            return result;
+        }
+        result.zero = false;
+        result.negative = (comparison < 0);
+        result.numbers = (comparison > 0) ? SubtractLimbs(plus, minus) : SubtractLimbs(minus, plus);
+        return result;
+    }
+
+    void clear() {
+        this->positive.clear();
+        this->negative.clear();
+        this->pending = 0;
+    }
+
+private:
+    void reserve(std::vector<uint64_t>& sum, size_t size) {
+        // Jeden volny limb navyse pre prenos pri normalizacii
+        if (sum.size() < size + 1) {
+            sum.resize(size + 1, 0);
+        }
+    }
+
+    void accumulate(std::vector<uint64_t>& sum, const std::vector<uint64_t>& limbs) {
+        this->reserve(sum, limbs.size());
+        for (size_t i = 0; i < limbs.size(); i++) {
+            sum[i] += limbs[i];
+        }
+        this->settle();
+    }
+
+    void settle() {
+        // Limb je vzdy < pending * MODULO; Normalizacia skor, nez by pretiekol uint64_t
+        this->pending++;
+        if (this->pending >= ACCUMULATOR_PENDING_LIMIT) {
+            Normalize(this->positive);
+            Normalize(this->negative);
+            this->pending = 1;
+        }
+    }
+
+    static void Normalize(std::vector<uint64_t>& sum) {
+        if (sum.empty()) {
+            sum.push_back(0);
+            return;
+        }
+        uint64_t carrying = 0;
+        for (uint64_t& limb : sum) {
+            carrying += limb;
+            limb = carrying % MODULO;
+            carrying /= MODULO;
+        }
+        while (carrying > 0) {
+            sum.push_back(carrying % MODULO);
+            carrying /= MODULO;
+        }
+        TrimLimbs(sum);
+    }
+
+    std::vector<uint64_t> positive;
+    std::vector<uint64_t> negative;
+    uint64_t pending;
+};
+
+
+// chinese remainder theorem: product tree of the moduli, remainder tree for reduce(), linear combination up the tree for reconstruct()
+class CRT
+{
+public:
+    explicit CRT(std::vector<BigInteger> moduli) {  // positive, pairwise coprime
+        if (moduli.empty()) {
+            throw std::runtime_error("CRT needs at least one modulus!");
+        }
+        for (const BigInteger& modulus : moduli) {
+            if (GetNegative(modulus) || GetZero(modulus)) {
+                throw std::runtime_error("Modulus must be positive!");
+            }
+        }
+        // tree[0] su moduly, tree[k][i] = tree[k-1][2i] * tree[k-1][2i+1]; koren je sucin M
+        this->tree.push_back(std::move(moduli));
+        while (this->tree.back().size() > 1) {
+            const std::vector<BigInteger>& level = this->tree.back();
+            std::vector<BigInteger> next;
+            next.reserve((level.size() + 1) / 2);
+            for (size_t i = 0; i < level.size(); i += 2) {
+                next.push_back((i + 1 < level.size()) ? (level[i] * level[i + 1]) : level[i]);
+            }
+            this->tree.push_back(std::move(next));
+        }
+
+        // (M / m_i) mod m_i = (M mod m_i^2) / m_i; zvysky M modulo stvorcov cez strom zvyskov
+        std::vector<BigInteger> remainders{this->modulus()};
+        for (size_t level = this->tree.size() - 1; level-- > 0;) {
+            remainders = this->descend(remainders, level, true);
+        }
+        this->inverses.reserve(this->size());
+        for (size_t i = 0; i < this->size(); i++) {
+            const BigInteger& modulus = this->tree[0][i];
+            BigInteger cofactor = remainders[i] / modulus;
+            if (!IsOne(gcd(cofactor, modulus)) && !IsOne(modulus)) {
+                throw std::runtime_error("CRT moduli must be pairwise coprime!");
+            }
+            this->inverses.push_back(inverse_mod(cofactor, modulus));
+        }
+    }
+
+    size_t size() const {
+        return this->tree[0].size();
+    }
+
+    const BigInteger& modulus() const {  // product of all moduli
+        return this->tree.back()[0];
+    }
+
+    const std::vector<BigInteger>& moduli() const {
+        return this->tree[0];
+    }
+
+    BigInteger reconstruct(std::span<const BigInteger> residues) const {  // x in [0, M) with x = residues[i] (mod m_i)
+        if (residues.size() != this->size()) {
+            throw std::runtime_error("CRT residue count does not match moduli!");
+        }
+        // Listy: r_i * (M/m_i)^(-1) mod m_i; uzol: lavy * sucin_pravy + pravy * sucin_lavy
+        std::vector<BigInteger> values;
+        values.reserve(this->size());
+        for (size_t i = 0; i < this->size(); i++) {
+            BigInteger value = residues[i] * this->inverses[i];
+            value %= this->tree[0][i];
+            values.push_back(std::move(value));
+        }
+        for (size_t level = 0; level + 1 < this->tree.size(); level++) {
+            const std::vector<BigInteger>& products = this->tree[level];
+            std::vector<BigInteger> next;
+            next.reserve((values.size() + 1) / 2);
+            for (size_t i = 0; i < values.size(); i += 2) {
+                if (i + 1 < values.size()) {
+                    BigInteger combined = values[i] * products[i + 1];
+                    combined += values[i + 1] * products[i];
+                    next.push_back(std::move(combined));
+                }
+                else {
+                    next.push_back(std::move(values[i]));
+                }
+            }
+            values = std::move(next);
+        }
+        BigInteger result = values[0] % this->modulus();
+        if (GetNegative(result)) {
+            result += this->modulus();
+        }
+        return result;
+    }
+
+    std::vector<BigInteger> reduce(const BigInteger& x) const {  // x mod m_i in [0, m_i) for every modulus
+        std::vector<BigInteger> remainders{x % this->modulus()};
+        if (GetNegative(remainders[0])) {
+            remainders[0] += this->modulus();
+        }
+        for (size_t level = this->tree.size() - 1; level-- > 0;) {
+            remainders = this->descend(remainders, level, false);
+        }
+        return remainders;
+    }
+
+private:
+    std::vector<std::vector<BigInteger>> tree;
+    std::vector<BigInteger> inverses;
+
+    std::vector<BigInteger> descend(const std::vector<BigInteger>& parents, size_t level, bool squares) const {  // parents[i / 2] mod tree[level][i] (or its square)
+        const std::vector<BigInteger>& nodes = this->tree[level];
+        std::vector<BigInteger> children;
+        children.reserve(nodes.size());
+        for (size_t i = 0; i < nodes.size(); i++) {
+            if (squares) {
+                BigInteger square = nodes[i];
+                square *= square;
+                children.push_back(parents[i / 2] % square);
+            }
+            else {
+                children.push_back(parents[i / 2] % nodes[i]);
+            }
+        }
+        return children;
+    }
+};
+
+
+// primality
+inline std::optional<bool> TrialDivision(const BigInteger& n) {  // decided result, or nullopt when undecided
+    // Jednolimbove cislo; Delenie az po odmocninu rozhodne uplne (SMALL_PRIMES_LIMIT^2 > MODULO)
+    if (n.numbers.size() == 1) {
+        const uint64_t value = n.numbers[0];
+        for (uint32_t prime : SmallPrimes()) {
+            if (static_cast<uint64_t>(prime) * prime > value) { break; }
+            if (value % prime == 0) { return false; }
+        }
+        return (value > 1);
+    }
+    // Viaclimbove cislo je vacsie ako vsetky male prvocisla; NSD so sucinom skupiny prvocisel
+    for (uint64_t product : SmallPrimeProducts()) {
+        if (std::gcd(RemainderSmall(n, product), product) != 1) {
+            return false;
+        }
+    }
+    return std::nullopt;
+}
+
+inline bool IsPrime64(uint64_t n) {  // deterministic miller-rabin for n < 2^64
+    if (n < 2) { return false; }
+    for (uint64_t prime : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+        if (n % prime == 0) { return (n == prime); }
+    }
+    uint64_t d = n - 1;
+    int s = std::countr_zero(d);
+    d >>= s;
+    // Bazy 2 az 37 staci pre vsetky n < 3.3 * 10^24
+    for (uint64_t a : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+        uint64_t x = 1;
+        uint64_t base = a;
+        for (uint64_t e = d; e > 0; e >>= 1) {
+            if (e & 1) { x = static_cast<uint64_t>((static_cast<WideLimb>(x) * base) % n); }
+            base = static_cast<uint64_t>((static_cast<WideLimb>(base) * base) % n);
+        }
+        if (x == 1 || x == n - 1) { continue; }
+        bool witness = true;
+        for (int i = 1; i < s && witness; i++) {
+            x = static_cast<uint64_t>((static_cast<WideLimb>(x) * x) % n);
+            witness = (x != n - 1);
+        }
+        if (witness) { return false; }
+    }
+    return true;
+}
+
+inline std::optional<uint64_t> ToUInt64(const BigInteger& biginteger) {  // |biginteger| if < 2^64
+    if (biginteger.numbers.size() > 3) {
+        return std::nullopt;
+    }
+    WideLimb value = 0;
+    for (auto iterator = biginteger.numbers.rbegin(); iterator != biginteger.numbers.rend(); iterator++) {
+        value = (value * MODULO) + *iterator;
+    }
+    if (value > std::numeric_limits<uint64_t>::max()) {
+        return std::nullopt;
+    }
+    return static_cast<uint64_t>(value);
+}
+
+inline int JacobiSmall(int64_t a, const BigInteger& n) {  // Jacobi symbol (a/n), n odd positive
+    // (-1/n) = (-1)^((n-1)/2); n mod 4 je v najnizsom limbe (MODULO je delitelne 4)
+    const uint64_t n_mod_4 = n.numbers[0] % 4;
+    int result = 1;
+    if (a < 0) {
+        a = -a;
+        if (n_mod_4 == 3) { result = -result; }
+    }
+    // Vytiahnutie 2 z citatela: (2/n) = -1 pre n = 3, 5 (mod 8)
+    uint64_t x = static_cast<uint64_t>(a);
+    const uint64_t n_mod_8 = n.numbers[0] % 8;
+    while (x != 0 && x % 2 == 0) {
+        x /= 2;
+        if (n_mod_8 == 3 || n_mod_8 == 5) { result = -result; }
+    }
+    if (x == 1) { return result; }
+    // Kvadraticka reciprocita: (x/n) = (n/x) * (-1)^((x-1)/2 * (n-1)/2)
+    if (x % 4 == 3 && n_mod_4 == 3) { result = -result; }
+    uint64_t y = x;
+    x = RemainderSmall(n, y);
+    // Zvysok uz v uint64_t
+    while (x != 0) {
+        while (x % 2 == 0) {
+            x /= 2;
+            if (y % 8 == 3 || y % 8 == 5) { result = -result; }
+        }
+        std::swap(x, y);
+        if (x % 4 == 3 && y % 4 == 3) { result = -result; }
+        x %= y;
+    }
+    return (y == 1) ? result : 0;
+}
+
+inline bool StrongProbablePrime(const MontgomeryContext& context, const MontgomeryContext::Residue& base, const std::vector<uint32_t>& d, size_t s, const MontgomeryContext::Residue& one, const MontgomeryContext::Residue& minus_one) {
+    // Silny test: a^d = 1 alebo a^(d*2^r) = -1 pre nejake r < s
+    MontgomeryContext::Residue x = context.pow(base, d);
+    if (x == one || x == minus_one) {
+        return true;
+    }
+    for (size_t r = 1; r < s; r++) {
+        context.multiply(x, x, x);
+        if (x == minus_one) { return true; }
+        if (x == one) { return false; }
+    }
+    return false;
+}
+
+inline bool StrongLucasProbablePrime(const BigInteger& n, const MontgomeryContext& context) {
+    // Selfridge: prve D z 5, -7, 9, -11, ... s (D/n) = -1; P = 1, Q = (1-D)/4
+    int64_t D = 5;
+    for (size_t attempt = 0; ; attempt++) {
+        int jacobi = JacobiSmall(D, n);
+        if (jacobi == -1) { break; }
+        // Spolocny delitel s D (n je vacsie ako |D|)
+        if (jacobi == 0) { return false; }
+        D = (D > 0) ? -(D + 2) : -(D - 2);
+        // Pre stvorce vhodne D neexistuje
+        if (attempt == 10) {
+            BigInteger root = n.isqrt();
+            if ((root * root) == n) { return false; }
+        }
+    }
+    const int64_t Q = (1 - D) / 4;
+
+    // n + 1 = d * 2^s
+    std::vector<uint32_t> n_plus_one = ToBinaryWords(n + BigInteger(1));
+    size_t s = 0;
+    while (!GetBit(n_plus_one, s)) { s++; }
+    std::vector<uint32_t> d = ShiftRightWords(n_plus_one, s);
+
+    using Residue = MontgomeryContext::Residue;
+    const Residue mont_d = context.to_montgomery(BigInteger(D));
+    const Residue mont_q = context.to_montgomery(BigInteger(Q));
+
+    // U_1 = 1, V_1 = P = 1, Q^1
+    Residue U = context.one();
+    Residue V = U;
+    Residue Qk = mont_q;
+    Residue temp;
+    for (size_t i = BitLength(d) - 1; i-- > 0;) {
+        // Zdvojenie indexu: U_2k = U_k*V_k, V_2k = V_k^2 - 2Q^k
+        context.multiply(U, V, U);
+        context.multiply(V, V, V);
+        V = context.subtract(V, context.add(Qk, Qk));
+        context.multiply(Qk, Qk, Qk);
+        // Posun o 1: U_(k+1) = (P*U + V)/2, V_(k+1) = (D*U + P*V)/2
+        if (GetBit(d, i)) {
+            context.multiply(mont_d, U, temp);
+            U = context.half(context.add(U, V));
+            V = context.half(context.add(temp, V));
+            context.multiply(Qk, mont_q, Qk);
+        }
+    }
+
+    // Silny Lucasov test: U_d = 0 alebo V_(d*2^r) = 0 pre nejake r < s
+    if (MontgomeryContext::is_zero(U) || MontgomeryContext::is_zero(V)) {
+        return true;
+    }
+    for (size_t r = 1; r < s; r++) {
+        context.multiply(V, V, V);
+        V = context.subtract(V, context.add(Qk, Qk));
+        if (MontgomeryContext::is_zero(V)) { return true; }
+        context.multiply(Qk, Qk, Qk);
+    }
+    return false;
+}
+
+template <class URBG>
+bool IsProbablePrimeSieved(const BigInteger& n, size_t k, URBG& rng, MontgomeryContext& context) {  // n > 1 without factors below SMALL_PRIMES_LIMIT
+    // 2. Pod 2^64 deterministicky test
+    if (std::optional<uint64_t> value = ToUInt64(n)) {
+        return IsPrime64(*value);
+    }
+
+    // 3. Baillie-PSW: silny test so zakladom 2 + silny Lucasov test
+    context.reset(n);
+    const MontgomeryContext::Residue one = context.one();
+    const MontgomeryContext::Residue minus_one = context.subtract(context.to_montgomery(BigInteger(0)), one);
+
+    // n - 1 = d * 2^s; Rozklad sa robi iba raz
+    std::vector<uint32_t> n_minus_one = ToBinaryWords(n);
+    n_minus_one[0] -= 1;
+    size_t s = 0;
+    while (!GetBit(n_minus_one, s)) { s++; }
+    const std::vector<uint32_t> d = ShiftRightWords(n_minus_one, s);
+
+    if (!StrongProbablePrime(context, context.to_montgomery(BigInteger(2)), d, s, one, minus_one)) {
+        return false;
+    }
+    if (!StrongLucasProbablePrime(n, context)) {
+        return false;
+    }
+
+    // 4. Dalsich k kol s nahodnym zakladom z intervalu <2, N-2>
+    for (size_t test = 0; test < k; test++) {
+        BigInteger a = random_below(n - BigInteger(3), rng) + BigInteger(2);
+        if (!StrongProbablePrime(context, context.to_montgomery(a), d, s, one, minus_one)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class URBG>
+bool IsProbablePrime(const BigInteger& n, size_t k, URBG& rng, MontgomeryContext& context) {
+    STATS_SCOPE(BigOperation::PrimeTest, n.numbers.size());
+    // Cisla: 0, 1, zaporne nie su PRIME
+    if (n.zero || IsOne(n) || n.negative) {
+        return false;
+    }
+    // 1. Delenie malymi prvocislami
+    if (std::optional<bool> decided = TrialDivision(n)) {
+        return *decided;
+    }
+    return IsProbablePrimeSieved(n, k, rng, context);
+}
+
+template <class URBG>
+bool IsProbablePrime(const BigInteger& n, size_t k, URBG& rng) {
+    MontgomeryContext context;
+    return IsProbablePrime(n, k, rng, context);
+}
+
+
+// prime search
+#define PRIME_SIEVE_WINDOW 16384
+
+inline std::vector<uint8_t> SieveWindow(const BigInteger& start, size_t width) {  // marks start+i divisible by a small prime (other than itself)
+    std::vector<uint8_t> composite(width, 0);
+    for (uint32_t prime : SmallPrimes()) {
+        // Prvy nasobok prvocisla v okne
+        size_t index = (prime - RemainderSmall(start, prime)) % prime;
+        // Samotne prvocislo nie je zlozene
+        if (start <= BigInteger(prime) && (start + BigInteger(index)) == BigInteger(prime)) {
+            index += prime;
+        }
+        for (; index < width; index += prime) {
+            composite[index] = 1;
+        }
+    }
+    return composite;
+}
+
+inline BigInteger next_prime(const BigInteger& x) {  // smallest prime > x
+    // Ak x < 2
+    if (x < BigInteger(2)) {
+        return BigInteger(2);
+    }
+    std::mt19937_64& engine = BigInteger::RandomEngine();
+    MontgomeryContext context;
+
+    // Okno sa najprv preosieva malymi prvocislami, velky test iba pre prezivsich
+    BigInteger start = x + BigInteger(1);
+    while (true) {
+        std::vector<uint8_t> composite = SieveWindow(start, PRIME_SIEVE_WINDOW);
+        for (size_t i = 0; i < PRIME_SIEVE_WINDOW; i++) {
+            if (composite[i]) { continue; }
+            BigInteger candidate = start + BigInteger(i);
+            if (IsProbablePrimeSieved(candidate, 0, engine, context)) {
+                return candidate;
+            }
+        }
+        start += BigInteger(PRIME_SIEVE_WINDOW);
+    }
+}
+
+inline BigInteger prev_prime(const BigInteger& x) {  // largest prime < x
+    // Ak x <= 2, mensie prvocislo neexistuje
+    if (x <= BigInteger(2)) {
+        throw std::runtime_error("No prime below 2!");
+    }
+    std::mt19937_64& engine = BigInteger::RandomEngine();
+    MontgomeryContext context;
+
+    // Okna smerom nadol: <start, end>
+    BigInteger end = x - BigInteger(1);
+    while (true) {
+        BigInteger start = end - BigInteger(PRIME_SIEVE_WINDOW - 1);
+        if (start < BigInteger(2)) {
+            start = BigInteger(2);
+        }
+        size_t width = *ToUInt64(end - start) + 1;
+        std::vector<uint8_t> composite = SieveWindow(start, width);
+        for (size_t i = width; i-- > 0;) {
+            if (composite[i]) { continue; }
+            BigInteger candidate = start + BigInteger(i);
+            if (IsProbablePrimeSieved(candidate, 0, engine, context)) {
+                return candidate;
+            }
+        }
+        end = start - BigInteger(1);
+    }
+}
+
+inline std::vector<BigInteger> primes_in_range(const BigInteger& lo, const BigInteger& hi) {  // all primes in <lo, hi>
+    std::vector<BigInteger> primes;
+    BigInteger start = (lo < BigInteger(2)) ? BigInteger(2) : lo;
+    std::mt19937_64& engine = BigInteger::RandomEngine();
+    MontgomeryContext context;
+
+    while (start <= hi) {
+        // Posledne okno moze byt kratsie
+        BigInteger remaining = hi - start;
+        size_t width = (remaining < BigInteger(PRIME_SIEVE_WINDOW)) ? (*ToUInt64(remaining) + 1) : PRIME_SIEVE_WINDOW;
+        std::vector<uint8_t> composite = SieveWindow(start, width);
+        for (size_t i = 0; i < width; i++) {
+            if (composite[i]) { continue; }
+            BigInteger candidate = start + BigInteger(i);
+            if (IsProbablePrimeSieved(candidate, 0, engine, context)) {
+                primes.push_back(std::move(candidate));
+            }
+        }
+        start += BigInteger(width);
+    }
+    return primes;
+}
+
+inline std::vector<bool> is_prime_batch(std::span<const BigInteger> candidates, size_t k = 0, size_t threads = 0) {  // is_prime(k) of every candidate, in parallel
+    // Pocet vlakien: podla hardveru, najviac pocet kandidatov
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    threads = std::max<size_t>(1, std::min(threads, candidates.size()));
+
+    std::vector<uint8_t> results(candidates.size(), 0);
+    std::vector<std::exception_ptr> errors(threads);
+    std::atomic<size_t> next(0);
+    const uint64_t seed = std::random_device{}();
+
+    auto worker = [&](size_t id) {
+        // Kazde vlakno ma vlastny engine a Montgomery kontext (scratch sa znovu pouziva)
+        std::mt19937_64 engine(seed + id);
+        MontgomeryContext context;
+        try {
+            for (size_t i = next++; i < candidates.size(); i = next++) {
+                results[i] = IsProbablePrime(candidates[i], k, engine, context);
+            }
+        }
+        catch (...) {
+            errors[id] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t id = 1; id < threads; id++) {
+        pool.emplace_back(worker, id);
+    }
+    worker(0);
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) { std::rethrow_exception(error); }
+    }
+    return std::vector<bool>(results.begin(), results.end());
+}
+
+
+// integer roots: Newton from a double-precision seed, perfect powers filtered by residues before any root is taken
+#define PERFECT_POWER_TRIAL 64
+#define PERFECT_POWER_RESIDUES 6
+#define PERFECT_POWER_CHECK_MODULUS 4294967291ULL
+
+inline uint64_t PowMod64(uint64_t base, uint64_t exponent, uint64_t modulus) {  // base^exponent % modulus
+    uint64_t result = 1 % modulus;
+    base %= modulus;
+    for (; exponent > 0; exponent >>= 1) {
+        if (exponent & 1) { result = static_cast<uint64_t>((static_cast<WideLimb>(result) * base) % modulus); }
+        base = static_cast<uint64_t>((static_cast<WideLimb>(base) * base) % modulus);
+    }
+    return result;
+}
+
+inline BigInteger RootFloor(const BigInteger& n, uint64_t k) {  // floor(n^(1/k)), n > 0, k >= 2
+    // Odhad z frexp ma ~50 spravnych bitov; +4 ho posunie nad presny koren
+    auto [mantissa, exponent] = frexp(n);
+    if (static_cast<uint64_t>(exponent) <= k) {
+        return BigInteger(1);
+    }
+    const int64_t whole = exponent / static_cast<int64_t>(k);
+    const double fraction = (static_cast<double>(exponent - (whole * static_cast<int64_t>(k))) + std::log2(mantissa)) / static_cast<double>(k);
+    BigInteger guess;
+    if (whole <= 50) {
+        guess = BigInteger(static_cast<int64_t>(std::ldexp(std::exp2(fraction), static_cast<int>(whole))) + 4);
+    }
+    else {
+        guess = BigInteger(static_cast<int64_t>(std::ldexp(std::exp2(fraction), 50)) + 4);
+        guess *= pow(BigInteger(2), static_cast<uint64_t>(whole - 50));
+    }
+
+    // Newton zhora: x' = ((k-1) x + n / x^(k-1)) / k klesa, kym nedosiahne floor
+    const BigInteger degree(static_cast<int64_t>(k));
+    while (true) {
+        BigInteger value = n / pow(guess, k - 1);
+        value += guess * BigInteger(static_cast<int64_t>(k - 1));
+        value /= degree;
+        if (value >= guess) {
+            return guess;
+        }
+        guess = std::move(value);
+    }
+}
+
+inline std::pair<BigInteger, BigInteger> rootrem(const BigInteger& x, uint64_t k) {  // (r, x - r^k), r = x^(1/k) truncated toward zero
+    if (k == 0) {
+        throw std::runtime_error("Root degree must be positive!");
+    }
+    if (GetNegative(x) && k % 2 == 0) {
+        throw std::runtime_error("No even root of negative BigInteger");
+    }
+    if (k == 1 || GetZero(x) || IsOne(x)) {
+        return {x, BigInteger(0)};
+    }
+    BigInteger root = RootFloor(GetNegative(x) ? -x : x, k);
+    if (GetNegative(x)) {
+        root = -root;
+    }
+    BigInteger remainder = x - pow(root, k);
+    return {std::move(root), std::move(remainder)};
+}
+
+inline BigInteger iroot(const BigInteger& x, uint64_t k) {  // x^(1/k) truncated toward zero; floor for x >= 0
+    if (k == 0) {
+        throw std::runtime_error("Root degree must be positive!");
+    }
+    if (GetNegative(x) && k % 2 == 0) {
+        throw std::runtime_error("No even root of negative BigInteger");
+    }
+    if (k == 1 || GetZero(x) || IsOne(x)) {
+        return x;
+    }
+    BigInteger root = RootFloor(GetNegative(x) ? -x : x, k);
+    return GetNegative(x) ? -root : root;
+}
+
+inline std::optional<BigInteger> ExactRoot(const BigInteger& n, uint64_t p, double mantissa, int64_t exponent) {  // r with r^p = n, n = mantissa * 2^exponent > 1, p prime
+    // 1. n musi byt p-tou mocninou modulo prvocisla q = 1 (mod p): iba (q-1)/p zvyskov z q-1 prejde
+    const int64_t whole = exponent / static_cast<int64_t>(p);
+    if (whole > 50) {
+        size_t tested = 0;
+        for (uint64_t q = (2 * p) + 1; tested < PERFECT_POWER_RESIDUES && q < std::numeric_limits<uint64_t>::max() / MODULO; q += 2 * p) {
+            if (!IsPrime64(q)) { continue; }
+            tested++;
+            const uint64_t residue = RemainderSmall(n, q);
+            if (residue != 0 && PowMod64(residue, (q - 1) / p, q) != 1) {
+                return std::nullopt;
+            }
+        }
+        auto [root, remainder] = rootrem(n, p);
+        if (GetZero(remainder)) {
+            return root;
+        }
+        return std::nullopt;
+    }
+
+    // 2. Koren ma najviac ~51 bitov: kandidati okolo 2^(log2(n) / p), najprv porovnanie modulo jedneho prvocisla
+    const double fraction = (static_cast<double>(exponent - (whole * static_cast<int64_t>(p))) + std::log2(mantissa)) / static_cast<double>(p);
+    const uint64_t estimate = static_cast<uint64_t>(std::llround(std::ldexp(std::exp2(fraction), static_cast<int>(whole))));
+    const uint64_t residue = RemainderSmall(n, PERFECT_POWER_CHECK_MODULUS);
+    for (uint64_t candidate = std::max<uint64_t>(estimate, 3) - 1; candidate <= estimate + 1; candidate++) {
+        if (PowMod64(candidate, p, PERFECT_POWER_CHECK_MODULUS) != residue) { continue; }
+        BigInteger root(static_cast<int64_t>(candidate));
+        if (pow(root, p) == n) {
+            return root;
+        }
+    }
+    return std::nullopt;
+}
+
+inline uint64_t Valuation(const BigInteger& n, uint32_t prime) {  // exponent of prime in n, n != 0; O(log v) divisions instead of v
+    // Nahor: p^(2^j) pre vsetky j, kym delia n; Potom v < 2^k
+    std::vector<BigInteger> powers{BigInteger(prime)};
+    while (GetZero(n % powers.back())) {
+        powers.push_back(powers.back() * powers.back());
+    }
+    powers.pop_back();
+
+    // Nadol: binarne cifry v od najvyssej
+    BigInteger rest = n;
+    uint64_t valuation = 0;
+    for (size_t j = powers.size(); j-- > 0;) {
+        auto [quotient, remainder] = divmod(rest, powers[j]);
+        if (GetZero(remainder)) {
+            rest = std::move(quotient);
+            valuation += static_cast<uint64_t>(1) << j;
+        }
+    }
+    return valuation;
+}
+
+inline std::optional<std::pair<BigInteger, uint64_t>> is_perfect_power(const BigInteger& x) {  // (base, k) with base^k = x, k >= 2 largest possible; nullopt if none or |x| < 2
+    BigInteger base = GetNegative(x) ? -x : x;
+    if (base < BigInteger(2)) {
+        return std::nullopt;
+    }
+
+    // Exponent musi delit NSD exponentov malych prvocisel v rozklade (0 = ziadne nedelia)
+    uint64_t valuations = 0;
+    for (uint32_t prime : SmallPrimes()) {
+        if (prime >= PERFECT_POWER_TRIAL) { break; }
+        if (RemainderSmall(base, prime) != 0) { continue; }
+        valuations = std::gcd(valuations, Valuation(base, prime));
+        if (valuations == 1) {
+            return std::nullopt;
+        }
+    }
+
+    // Prvociselne exponenty p <= log2(n); po najdeni n = r^p pokracuje na r od toho isteho p (mensie uz zlyhali)
+    uint64_t exponent = 1;
+    uint64_t first = GetNegative(x) ? 3 : 2;
+    bool found = true;
+    while (found) {
+        found = false;
+        auto [mantissa, binary_exponent] = frexp(base);
+        for (uint32_t p : SievePrimes(static_cast<uint32_t>(binary_exponent) + 1)) {
+            if (p < first || (valuations != 0 && valuations % p != 0)) { continue; }
+            if (auto root = ExactRoot(base, p, mantissa, binary_exponent)) {
+                base = std::move(*root);
+                exponent *= p;
+                if (valuations != 0) { valuations /= p; }
+                first = p;
+                found = true;
+                break;
+            }
+        }
+    }
+    if (exponent == 1) {
+        return std::nullopt;
+    }
+    if (GetNegative(x)) {
+        base = -base;
+    }
+    return std::make_pair(std::move(base), exponent);
+}
+
+// factorization: trial division, then Pollard rho (Brent) and ECM stage 1 on cofactors, both in Montgomery form
+#define FACTOR_TRIAL_LIMIT 65536
+#define FACTOR_RHO_ITERATIONS (1 << 16)
+#define FACTOR_RHO_BATCH 128
+#define FACTOR_ECM_POLL 256
+
+inline BigInteger PollardBrent(const BigInteger& n, uint64_t c, uint64_t max_iterations) {  // nontrivial factor of n (odd, coprime to 10, composite) or 0
+    MontgomeryContext context(n);
+    const MontgomeryContext::Residue increment = context.to_montgomery(BigInteger(static_cast<int64_t>(c)));
+    auto step = [&](MontgomeryContext::Residue& value) {  // value = value^2 + c
+        context.multiply(value, value, value);
+        value = context.add(value, increment);
+    };
+
+    MontgomeryContext::Residue y = context.to_montgomery(BigInteger(2));
+    MontgomeryContext::Residue x;
+    MontgomeryContext::Residue saved;
+    MontgomeryContext::Residue product = context.one();
+    BigInteger divisor(1);
+
+    // Brent: x je y na pozicii 2^i, rozdiely x - y sa nasobia a NSD sa pocita raz za FACTOR_RHO_BATCH krokov
+    for (uint64_t r = 1; IsOne(divisor) && r <= max_iterations; r *= 2) {
+        x = y;
+        for (uint64_t i = 0; i < r; i++) {
+            step(y);
+        }
+        for (uint64_t k = 0; k < r && IsOne(divisor); k += FACTOR_RHO_BATCH) {
+            saved = y;
+            for (uint64_t i = 0; i < std::min<uint64_t>(FACTOR_RHO_BATCH, r - k); i++) {
+                step(y);
+                context.multiply(product, context.subtract(x, y), product);
+            }
+            divisor = gcd(context.from_montgomery(product), n);
+        }
+    }
+    // Davka prekrocila cyklus: prechod po jednom kroku od ulozenej hodnoty
+    if (divisor == n) {
+        divisor = BigInteger(1);
+        for (uint64_t i = 0; IsOne(divisor) && i < FACTOR_RHO_BATCH; i++) {
+            step(saved);
+            divisor = gcd(context.from_montgomery(context.subtract(x, saved)), n);
+        }
+    }
+    if (IsOne(divisor) || divisor == n) {
+        return BigInteger(0);
+    }
+    return divisor;
+}
+
+struct EcmPoint  // (X : Z) on a Montgomery curve, Montgomery residues
+{
+    MontgomeryContext::Residue x;
+    MontgomeryContext::Residue z;
+};
+
+inline BigInteger EcmStageOne(const MontgomeryContext& context, uint64_t sigma, const std::vector<uint32_t>& primes, uint32_t bound, const std::atomic<bool>& stop) {  // gcd of Z after [prime powers <= bound] on Suyama's curve 'sigma', 0 if stopped
+    using Residue = MontgomeryContext::Residue;
+    const BigInteger& n = context.get_modulus();
+    auto small = [&context](uint64_t value) { return context.to_montgomery(BigInteger(static_cast<int64_t>(value))); };
+    auto multiply = [&context](const Residue& a, const Residue& b) { return context.multiply(a, b); };
+
+    // Suyama: u = s^2 - 5, v = 4s, P = (u^3 : v^3), (A + 2C : 4C) = ((v - u)^3 (3u + v) : 16 u^3 v); bez inverzie
+    const Residue s = small(sigma);
+    const Residue u = context.subtract(multiply(s, s), small(5));
+    const Residue v = multiply(small(4), s);
+    const Residue u3 = multiply(multiply(u, u), u);
+    const Residue difference = context.subtract(v, u);
+    const Residue a24 = multiply(multiply(multiply(difference, difference), difference), context.add(multiply(small(3), u), v));
+    const Residue c24 = multiply(multiply(small(16), u3), v);
+    BigInteger divisor = gcd(context.from_montgomery(c24), n);
+    if (!IsOne(divisor)) {
+        return divisor;
+    }
+
+    auto dbl = [&](const EcmPoint& p) {
+        Residue minus = context.subtract(p.x, p.z);
+        Residue plus = context.add(p.x, p.z);
+        minus = multiply(minus, minus);
+        plus = multiply(plus, plus);
+        EcmPoint result;
+        result.z = multiply(c24, minus);
+        result.x = multiply(result.z, plus);
+        plus = context.subtract(plus, minus);
+        result.z = multiply(context.add(result.z, multiply(a24, plus)), plus);
+        return result;
+    };
+    auto add = [&](const EcmPoint& p, const EcmPoint& q, const EcmPoint& base) {  // p + q, base = p - q
+        Residue t0 = multiply(context.add(p.x, p.z), context.subtract(q.x, q.z));
+        Residue t1 = multiply(context.subtract(p.x, p.z), context.add(q.x, q.z));
+        Residue sum = context.add(t0, t1);
+        Residue sub = context.subtract(t0, t1);
+        return EcmPoint{multiply(base.z, multiply(sum, sum)), multiply(base.x, multiply(sub, sub))};
+    };
+
+    EcmPoint point{u3, multiply(multiply(v, v), v)};
+    for (size_t i = 0; i < primes.size() && primes[i] <= bound; i++) {
+        if (i % FACTOR_ECM_POLL == 0 && stop.load(std::memory_order_relaxed)) {
+            return BigInteger(0);
+        }
+        // Najvyssia mocnina prvocisla <= bound
+        uint64_t power = primes[i];
+        while (power * primes[i] <= bound) {
+            power *= primes[i];
+        }
+        // Montgomery ladder
+        EcmPoint low = point;
+        EcmPoint high = dbl(point);
+        for (int bit = std::bit_width(power) - 2; bit >= 0; bit--) {
+            if ((power >> bit) & 1) {
+                low = add(high, low, point);
+                high = dbl(high);
+            }
+            else {
+                high = add(high, low, point);
+                low = dbl(low);
+            }
+        }
+        point = std::move(low);
+    }
+    return gcd(context.from_montgomery(point.z), n);
+}
+
+inline BigInteger EcmFactor(const BigInteger& n, size_t threads) {  // nontrivial factor of n (odd, coprime to 10, composite)
+    // (B1, pocet kriviek) podla velkosti hladaneho faktora: ~15, 20, 25, 30, 35 cifier; posledna uroven sa opakuje
+    static constexpr std::array<std::pair<uint32_t, uint32_t>, 5> LEVELS = {{{2000, 25}, {11000, 90}, {50000, 300}, {250000, 700}, {1000000, 1800}}};
+    std::atomic<bool> found(false);
+    std::atomic<uint64_t> next_sigma(6);
+    BigInteger result;
+    std::mutex result_mutex;
+    std::vector<std::exception_ptr> errors(threads);
+
+    for (size_t level = 0; !found; level = std::min(level + 1, LEVELS.size() - 1)) {
+        const auto [bound, curves] = LEVELS[level];
+        const std::vector<uint32_t> primes = SievePrimes(bound + 1);
+        std::atomic<uint32_t> started(0);
+
+        // Kazde vlakno ma vlastny Montgomery kontext, krivky si berie z pocitadla
+        auto worker = [&](size_t id) {
+            try {
+                MontgomeryContext context(n);
+                while (!found && started++ < curves) {
+                    BigInteger divisor = EcmStageOne(context, next_sigma++, primes, bound, found);
+                    if (!GetZero(divisor) && !IsOne(divisor) && divisor != n) {
+                        std::lock_guard<std::mutex> lock(result_mutex);
+                        if (!found) {
+                            result = std::move(divisor);
+                            found = true;
+                        }
+                    }
+                }
+            }
+            catch (...) {
+                errors[id] = std::current_exception();
+                found = true;
+            }
+        };
+        std::vector<std::thread> pool;
+        for (size_t id = 1; id < threads; id++) {
+            pool.emplace_back(worker, id);
+        }
+        worker(0);
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+        for (const std::exception_ptr& error : errors) {
+            if (error) { std::rethrow_exception(error); }
+        }
+    }
+    return result;
+}
+
+inline std::vector<std::pair<BigInteger, uint64_t>> factor(const BigInteger& n, size_t threads = 1) {  // prime factorization of |n| as (prime, exponent), primes ascending; empty for 1
+    if (GetZero(n)) {
+        throw std::runtime_error("Factoring 0!");
+    }
+    threads = std::max<size_t>(1, threads);
+    BigInteger rest = GetNegative(n) ? -n : n;
+    std::vector<BigInteger> primes;
+
+    // 1. Delenie prvocislami < FACTOR_TRIAL_LIMIT, kym p^2 <= zvysok
+    for (uint32_t prime : SievePrimes(FACTOR_TRIAL_LIMIT)) {
+        if (BigInteger(static_cast<int64_t>(prime) * prime) > rest) {
+            break;
+        }
+        while (RemainderSmall(rest, prime) == 0) {
+            rest /= BigInteger(prime);
+            primes.emplace_back(prime);
+        }
+    }
+
+    // 2. Zlozene zvysky: rho (par konstant c), potom ECM
+    std::mt19937_64 engine(std::random_device{}());
+    MontgomeryContext context;
+    std::vector<std::pair<BigInteger, uint64_t>> pending;  // (cislo, nasobnost)
+    if (!IsOne(rest)) {
+        pending.emplace_back(std::move(rest), 1);
+    }
+    while (!pending.empty()) {
+        auto [current, multiplicity] = std::move(pending.back());
+        pending.pop_back();
+        if (current < BigInteger(static_cast<int64_t>(FACTOR_TRIAL_LIMIT) * FACTOR_TRIAL_LIMIT) || IsProbablePrime(current, 0, engine, context)) {
+            primes.insert(primes.end(), multiplicity, current);
+            continue;
+        }
+        // Mocnina r^k: r sa rozklada iba raz, s k-nasobnou nasobnostou
+        if (auto power = is_perfect_power(current)) {
+            pending.emplace_back(std::move(power->first), multiplicity * power->second);
+            continue;
+        }
+        BigInteger divisor;
+        for (uint64_t c = 1; c <= 3 && GetZero(divisor); c++) {
+            divisor = PollardBrent(current, c, FACTOR_RHO_ITERATIONS);
+        }
+        if (GetZero(divisor)) {
+            divisor = EcmFactor(current, threads);
+        }
+        BigInteger cofactor = current / divisor;
+        pending.emplace_back(std::move(divisor), multiplicity);
+        pending.emplace_back(std::move(cofactor), multiplicity);
+    }
+
+    // Zoskupenie rovnakych prvocisel
+    std::sort(primes.begin(), primes.end());
+    std::vector<std::pair<BigInteger, uint64_t>> factors;
+    for (BigInteger& prime : primes) {
+        if (!factors.empty() && factors.back().first == prime) {
+            factors.back().second++;
+        }
+        else {
+            factors.emplace_back(std::move(prime), 1);
+        }
+    }
+    return factors;
+}
+
+#if SUPPORT_ASYNC == 1
+// async operations: each runs as one task on a BigExecutor and throws BigCancelled (through the future) once its stop_token fires
+class BigExecutor
+{
+public:
+    virtual ~BigExecutor() = default;
+    virtual void submit(std::function<void()> task) = 0;
+};
+
+class BigThreadPool : public BigExecutor  // fixed workers over one FIFO queue; tasks still queued at destruction are dropped
+{
+public:
+    explicit BigThreadPool(size_t threads = 0) {  // 0 = hardware concurrency
+        if (threads == 0) {
+            threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+        for (size_t i = 0; i < threads; i++) {
+            this->workers.emplace_back([this](std::stop_token stop) { this->work(stop); });
+        }
+    }
+
+    BigThreadPool(const BigThreadPool&) = delete;
+    BigThreadPool& operator=(const BigThreadPool&) = delete;
+
+    ~BigThreadPool() override {
+        // std::jthread poziada o zastavenie a pocka; Bezace ulohy dobehnu
+        for (std::jthread& worker : this->workers) {
+            worker.request_stop();
+        }
+        this->ready.notify_all();
+    }
+
+    void submit(std::function<void()> task) override {
+        {
+            std::lock_guard<std::mutex> lock(this->lock);
+            this->tasks.push_back(std::move(task));
+        }
+        this->ready.notify_one();
+    }
+
+    size_t size() const {
+        return this->workers.size();
+    }
+
+private:
+    std::mutex lock;
+    std::condition_variable_any ready;
+    std::deque<std::function<void()>> tasks;
+    std::vector<std::jthread> workers;  // posledny clen: vlakna koncia skor, nez zanikne fronta
+
+    void work(std::stop_token stop) {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(this->lock);
+                if (!this->ready.wait(lock, stop, [this] { return !this->tasks.empty(); })) {
+                    return;
+                }
+                task = std::move(this->tasks.front());
+                this->tasks.pop_front();
+            }
+            task();
+        }
+    }
+};
+
+inline BigExecutor& default_executor() {  // process-wide pool with one worker per hardware thread
+    static BigThreadPool pool;
+    return pool;
+}
+
+template <class Function>
+auto SubmitCancellable(BigExecutor& executor, std::stop_token stop, Function function) -> std::future<std::invoke_result_t<Function&>> {
+    using Result = std::invoke_result_t<Function&>;
+    // std::function musi byt kopirovatelna, preto promise cez shared_ptr
+    auto promise = std::make_shared<std::promise<Result>>();
+    std::future<Result> future = promise->get_future();
+    executor.submit([promise, stop = std::move(stop), function = std::move(function)]() mutable {
+        BigCancelScope scope(stop);
+        try {
+            // Zrusene este vo fronte
+            PollCancel();
+            promise->set_value(function());
+        }
+        catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return future;
+}
+
+inline std::future<BigInteger> multiply_async(BigInteger lhs, BigInteger rhs, std::stop_token stop = {}, BigExecutor& executor = default_executor()) {
+    return SubmitCancellable(executor, std::move(stop), [lhs = std::move(lhs), rhs = std::move(rhs)]() mutable {
+        lhs *= rhs;
+        return std::move(lhs);
+    });
+}
+
+inline std::future<std::pair<BigInteger, BigInteger>> divmod_async(BigInteger lhs, BigInteger rhs, std::stop_token stop = {}, BigExecutor& executor = default_executor()) {
+    return SubmitCancellable(executor, std::move(stop), [lhs = std::move(lhs), rhs = std::move(rhs)] {
+        return divmod(lhs, rhs);
+    });
+}
+
+inline std::future<BigInteger> pow_mod_async(BigInteger base, BigInteger exponent, BigInteger modulus, std::stop_token stop = {}, BigExecutor& executor = default_executor()) {
+    return SubmitCancellable(executor, std::move(stop), [base = std::move(base), exponent = std::move(exponent), modulus = std::move(modulus)] {
+        return pow_mod(base, exponent, modulus);
+    });
+}
+
+#if SUPPORT_MORE_OPS == 1
+inline std::future<BigInteger> isqrt_async(BigInteger value, std::stop_token stop = {}, BigExecutor& executor = default_executor()) {
+    return SubmitCancellable(executor, std::move(stop), [value = std::move(value)] {
+        return value.isqrt();
+    });
+}
+
+inline std::future<bool> is_prime_async(BigInteger value, size_t k, std::stop_token stop = {}, BigExecutor& executor = default_executor()) {
+    return SubmitCancellable(executor, std::move(stop), [value = std::move(value), k] {
+        return value.is_prime(k);
+    });
+}
+#endif
+
+inline std::future<std::string> to_string_async(BigInteger value, std::stop_token stop = {}, BigExecutor& executor = default_executor()) {
+    return SubmitCancellable(executor, std::move(stop), [value = std::move(value)] {
+        return value.to_string();
+    });
+}
+#endif
+
+#if SUPPORT_FILES == 1
+// decimal files: limbs are base 10^9, so every 9-digit block of the file is exactly one limb and blocks convert independently
+#define FILE_LIMBS_PER_THREAD 65536
+
+template <class Function>
+void ParallelRanges(size_t count, size_t threads, Function&& function) {  // function(from, to) on contiguous parts of [0, count)
+    // Pocet vlakien: podla hardveru, kazde aspon FILE_LIMBS_PER_THREAD limbov
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    threads = std::max<size_t>(1, std::min(threads, count / FILE_LIMBS_PER_THREAD));
+
+    std::vector<std::exception_ptr> errors(threads);
+    auto worker = [&](size_t id) {
+        try {
+            function((count * id) / threads, (count * (id + 1)) / threads);
+        }
+        catch (...) {
+            errors[id] = std::current_exception();
         }
-        this->numbers = rhs.numbers;
-        this->negative = rhs.negative;
-        this->zero = rhs.zero;
-        
-        return *this;
     };
-    
 
-    // unary operators
-    const BigInteger& operator+() const {
-        return *this;
-    };
+    std::vector<std::thread> pool;
+    for (size_t id = 1; id < threads; id++) {
+        pool.emplace_back(worker, id);
+    }
+    worker(0);
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) { std::rethrow_exception(error); }
+    }
+}
 
-    BigInteger operator-() const {
-        if (this->zero) {
-            return *this;
+class MappedFile  // POSIX mmap of a whole file, unmapped on destruction
+{
+public:
+    MappedFile(const std::string& path) {  // read-only
+        this->descriptor = ::open(path.c_str(), O_RDONLY);
+        if (this->descriptor < 0) {
+            throw std::runtime_error("Cannot open " + path + "!");
         }
-        // Potreba vytvorenia noveho objektu + zmena znamienka
-        BigInteger copied = *this;
-        copied.negative = !(this->negative);
-        
-        return copied;
-    };
-    
-    
-    // binary arithmetics operators
-    BigInteger& operator+=(const BigInteger& rhs) {
-        // Ak A+0
-        if (rhs.zero) {
-            return *this;
+        struct stat status;
+        if (::fstat(this->descriptor, &status) != 0) {
+            this->close();
+            throw std::runtime_error("Cannot read " + path + "!");
         }
-        // Ak 0+B
-        if (this->zero) {
-            *this = rhs;
-            return *this;
+        this->map(static_cast<size_t>(status.st_size), PROT_READ, path);
+        if (this->length > 0) {
+            ::madvise(this->address, this->length, MADV_SEQUENTIAL);
         }
+    };
 
-        // ABY SA VYKONALO SCITANIE, ZNAMIENKA SA MUSIA ROVNAT
-        // Musi sa zavolat odcitanie; Nerovnost znamienok
-        if (this->negative != rhs.negative) {
-            *this -= -rhs;
-            return *this;
+    MappedFile(const std::string& path, size_t size) {  // created or truncated to 'size' bytes, writable
+        this->descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (this->descriptor < 0) {
+            throw std::runtime_error("Cannot open " + path + "!");
         }
-
-        // Resize vektora na znamu velkost
-        this->numbers.resize(std::max(this->numbers.size(), rhs.numbers.size()), 0);
-
-        uint64_t carrying = 0;
-        // Pripocitavanie aj 'rhs' pokial je, inak iba pripocitanie 'this' ku carrying
-        for (size_t i = 0; i < this->numbers.size(); i++) {
-            if (i < rhs.numbers.size()) {
-                carrying += rhs.numbers[i];
-            }
-            // Ak sa uz nepripocitava z 'rhs'
-            else {
-                // Identifikovanie mozneho predcasneho ukoncenie
-                if (carrying == 0) { break; }
-            }
-            carrying += this->numbers[i];
-            this->numbers[i] = carrying % MODULO;
-            carrying /= MODULO;
+        if (::ftruncate(this->descriptor, static_cast<off_t>(size)) != 0) {
+            this->close();
+            throw std::runtime_error("Cannot resize " + path + "!");
         }
+        this->map(size, PROT_READ | PROT_WRITE, path);
+    };
 
-        // Pridanie zvysku do vektora z posledneho scitania
-        if (carrying > 0) {
-            this->numbers.push_back(carrying);
-        }
-    
-        return *this;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        this->close();
     };
 
-    BigInteger& operator-=(const BigInteger& rhs) {
-        // Ak A-0
-        if (rhs.zero) {
-            return *this;
+    char* data() const { return static_cast<char*>(this->address); }
+    size_t size() const { return this->length; }
+
+private:
+    void map(size_t size, int protection, const std::string& path) {
+        this->length = size;
+        // Prazdny subor sa nemapuje
+        if (size == 0) {
+            return;
         }
-        // Ak 0-B; Potreba zmenit znamienko
-        if (this->zero) {
-            *this = rhs;
-            this->negative = !(this->negative);
-            return *this;
+        this->address = ::mmap(nullptr, size, protection, MAP_SHARED, this->descriptor, 0);
+        if (this->address == MAP_FAILED) {
+            this->address = nullptr;
+            this->close();
+            throw std::runtime_error("Cannot map " + path + "!");
         }
+    };
 
-        // ABY SA VYKONALO ODCITANIE, ZNAMIENKA SA MUSIA ROVNAT
-        // Musi sa zavolat scitanie; Nerovnost znamienok
-        if (this->negative != rhs.negative) {
-            *this += -rhs;
-            return *this;
+    void close() {
+        if (this->address != nullptr) {
+            ::munmap(this->address, this->length);
+            this->address = nullptr;
         }
-        // Ak A=B; Vysledok je 0
-        if (*this == rhs) {
-            SetToZero(*this);
-            return *this;
+        if (this->descriptor >= 0) {
+            ::close(this->descriptor);
+            this->descriptor = -1;
         }
+    };
 
-        bool this_smaller = (*this < rhs);
-        // 2 pripady, kedy sa odcitava vacsie od mensieho; Treba cisla prehodit a zmenit znamienko
-        if ((!this->negative && this_smaller) || (this->negative && !this_smaller)) {
-            *this = (rhs - *this);
-            this->negative = !(this->negative);
-            return *this;
-        }
+    int descriptor = -1;
+    void* address = nullptr;
+    size_t length = 0;
+};
 
-        uint64_t taking = 0;
-        // Odcitavanie 'taking' a 'rhs' pokial je
-        for (size_t i = 0; i < this->numbers.size(); i++) {
-            int64_t difference = this->numbers[i] - taking;
-            if (i < rhs.numbers.size()) {
-                difference -= rhs.numbers[i];
-            }
-            // Ak sa uz neodcitava z 'rhs'
-            else {
-                // Identifikovanie mozneho predcasneho ukoncenie
-                if (static_cast<uint64_t>(difference) == this->numbers[i]) {
-                    break;
+inline BigInteger BigInteger::load_decimal(const std::string& path, size_t threads) {
+    const MappedFile file(path);
+    const char* text = file.data();
+    size_t begin = 0;
+    size_t end = file.size();
+
+    // Biele znaky na zaciatku a konci (napr. '\n'), potom znamienko
+    while (begin < end && IsSpace(text[begin])) { begin++; }
+    while (end > begin && IsSpace(text[end - 1])) { end--; }
+    bool negative = false;
+    if (begin < end && (text[begin] == '-' || text[begin] == '+')) {
+        negative = (text[begin] == '-');
+        begin++;
+    }
+    if (begin == end) {
+        throw std::runtime_error("Invalid number in " + path + "!");
+    }
+
+    // Limb i = cifry [end - 9*(i+1), end - 9*i); Bloky limbov sa konvertuju paralelne priamo do vysledku
+    BigInteger result;
+    const size_t count = ((end - begin) + DIGITS - 1) / DIGITS;
+    result.numbers.assign(count, 0);
+    ParallelRanges(count, threads, [&](size_t from, size_t to) {
+        for (size_t i = from; i < to; i++) {
+            const size_t last = end - (DIGITS * i);
+            const size_t first = (last - begin > DIGITS) ? (last - DIGITS) : begin;
+            uint64_t part = 0;
+            for (size_t j = first; j < last; j++) {
+                if (!IsDigit(text[j])) {
+                    throw std::runtime_error("Invalid number in " + path + "!");
                 }
+                part = (part * 10) + (text[j] - '0');
             }
-            // Musime odcitat 1 z nasledujuceho + opravit 'difference'
-            if (difference < 0) {
-                difference += MODULO;
-                taking = 1;
-            }
-            // Nemusime odcitat 1 z nasledujuceho
-            else { taking = 0; }
-            
-            this->numbers[i] = difference;
+            result.numbers[i] = part;
         }
+    });
 
-        // Odstranenie zbytocnych 0 z konca vektora
-        while (this->numbers.back() == 0) {
-            this->numbers.pop_back();
-        }
+    // Odstranenie nul na zaciatku cisla
+    TrimLimbs(result.numbers);
+    result.zero = (result.numbers.size() == 1 && result.numbers[0] == 0);
+    result.negative = negative && !result.zero;
+    return result;
+}
 
-        return *this;
-    };
+inline void BigInteger::save_decimal(const std::string& path, size_t threads) const {
+    // Velkost suboru je znama vopred: znamienko + cifry najvyssieho limbu + 9 cifier za kazdy dalsi limb
+    size_t top_digits = 1;
+    for (uint64_t top = this->numbers.back(); top >= 10; top /= 10) {
+        top_digits++;
+    }
+    const size_t offset = (this->negative ? 1 : 0) + top_digits;
+    MappedFile file(path, offset + (DIGITS * (this->numbers.size() - 1)));
+    char* text = file.data();
 
-    BigInteger& operator*=(const BigInteger& rhs) {
-        // Ak 0*B
-        if (this->zero) {
-            return *this;
+    if (this->negative) {
+        text[0] = '-';
+    }
+    for (uint64_t top = this->numbers.back(), i = offset; i-- > offset - top_digits; top /= 10) {
+        text[i] = static_cast<char>('0' + (top % 10));
+    }
+
+    // Ostatne limby s prefixovymi nulami, paralelne po blokoch; Limb i konci na pozicii offset + 9*(n-1-i)
+    const size_t count = this->numbers.size() - 1;
+    ParallelRanges(count, threads, [&](size_t from, size_t to) {
+        for (size_t i = from; i < to; i++) {
+            uint64_t part = this->numbers[i];
+            char* position = text + offset + (DIGITS * (count - i));
+            for (size_t j = 0; j < DIGITS; j++) {
+                *(--position) = static_cast<char>('0' + (part % 10));
+                part /= 10;
+            }
         }
-        // Ak A*0
-        if (rhs.zero) {
-            SetToZero(*this);
-            return *this;
+    });
+}
+#endif
+
+template <BigIntegerLiteral S>
+struct BigIntegerLiteralTable
+{
+    // Parsovanie prebehne iba v case kompilacie; V programe zostane staticka tabulka limbov
+    static constexpr size_t SIZE = BigInteger(std::string(S.text)).numbers.size();
+    static constexpr bool NEGATIVE = BigInteger(std::string(S.text)).negative;
+    static constexpr bool ZERO = BigInteger(std::string(S.text)).zero;
+
+    static constexpr std::array<uint64_t, SIZE> limbs = [] {
+        BigInteger parsed(std::string(S.text));
+        std::array<uint64_t, SIZE> table{};
+        for (size_t i = 0; i < SIZE; i++) {
+            table[i] = parsed.numbers[i];
         }
-        // Ak 1*B
-        if (IsOne(*this)) {
-            bool old_negative = this->negative;
-            *this = rhs;
-            this->negative = !(old_negative == rhs.negative);
-            return *this;
+        return table;
+    }();
+
+    static constexpr BigInteger value() {
+        // Iba skopirovanie limbov, bez parsovania
+        BigInteger result;
+        result.numbers.assign(limbs.begin(), limbs.end());
+        result.negative = NEGATIVE;
+        result.zero = ZERO;
+        return result;
+    }
+};
+
+template <BigIntegerLiteral S>
+constexpr BigInteger operator""_big() {
+    return BigIntegerLiteralTable<S>::value();
+}
+
+
+#if SUPPORT_IFSTREAM == 1
+// this should behave exactly the same as reading int with respect to 
+// whitespace, consumed characters etc...
+inline std::istream& operator>>(std::istream& lhs, BigInteger& rhs) { // bonus
+    // sentry preskoci biele znaky (ak je nastavene std::skipws)
+    std::istream::sentry sentry(lhs);
+    if (!sentry) {
+        return lhs;
+    }
+    std::string text;
+    int next = lhs.peek();
+    if (next == '+' || next == '-') {
+        text += static_cast<char>(lhs.get());
+        next = lhs.peek();
+    }
+
+    // Zaklad podla std::dec / std::hex / std::oct; Bez nastavenia rozhodne prefix ako pri %i
+    const std::ios_base::fmtflags basefield = lhs.flags() & std::ios_base::basefield;
+    int base = (basefield == std::ios_base::hex) ? 16 : (basefield == std::ios_base::oct) ? 8 : (basefield == std::ios_base::dec) ? 10 : 0;
+    bool digits = false;
+    if ((base == 16 || base == 0) && next == '0') {
+        text += static_cast<char>(lhs.get());
+        digits = true;
+        next = lhs.peek();
+        // Po "0x" musi nasledovat aspon jedna cifra
+        if (next == 'x' || next == 'X') {
+            lhs.get();
+            next = lhs.peek();
+            base = 16;
+            digits = false;
         }
-        // Ak A*1
-        if (IsOne(rhs)) {
-            this->negative = !(this->negative == rhs.negative);
-            return *this;
+        else if (base == 0) {
+            base = 8;
         }
+    }
+    if (base == 0) {
+        base = 10;
+    }
+    while (next != std::char_traits<char>::eof() && RadixDigit(next) < base) {
+        text += static_cast<char>(lhs.get());
+        digits = true;
+        next = lhs.peek();
+    }
 
-        // Nastavenie spravneho znamienka
-        this->negative = !(this->negative == rhs.negative);
+    // Ziadna cifra: ako pri int hodnota 0 a failbit
+    if (!digits) {
+        rhs = BigInteger(0);
+        lhs.setstate(std::ios_base::failbit);
+        return lhs;
+    }
+    rhs = BigInteger::from_string(text, base);
+    return lhs;
+}
+#endif
 
-        // Vytvorenie noveho vektora na ukladanie medzivysledkov
-        std::vector<uint64_t> storage(this->numbers.size() + rhs.numbers.size(), 0);
 
-        // Loop, ktory berie kazde cislo z 'this'
-        for (size_t i = 0; i < this->numbers.size(); i++) {
-            // Nasobenie 0-lou nema ziadny efekt na vysledok
-            if (this->numbers[i] == 0) { continue; }
-            
-            uint64_t carrying = 0;
+// fixed-width integers (std::array limbs, no heap allocations)
+// Limby su v zaklade 2^64 (little-endian), aritmetika je modulo 2^Bits ako pri unsigned typoch
 
-            // Loop, ktory nasobi kazde 'rhs' s aktualnym 'this'
-            for (size_t j = 0; (j < rhs.numbers.size() || carrying > 0); j++) {
-                // Aktualna hodnota indexu + co sa prenasa
-                uint64_t total = storage[i+j] + carrying;
-                
-                // Klasicke nasobenie (kazde s kazdym); Na oddelenie, ak na konci nasobeni zostanu prebytocne zvysky, ktore treba spracovat osobitne
-                if (j < rhs.numbers.size()) {
-                    total +=  (this->numbers[i] * rhs.numbers[j]);
-                }
+template <size_t Bits>
+class FixedBigInt;
 
-                storage[i+j] = total % MODULO;
-                carrying = total / MODULO;
-            }
-        }
+template <size_t M, size_t N>
+constexpr void FixedDivideLimbs(const std::array<uint64_t, M>& u, const std::array<uint64_t, N>& v, std::array<uint64_t, M>& quotient, std::array<uint64_t, N>& remainder) {
+    // Knuth, algoritmus D v zaklade 2^64; Slucky zavisia od efektivnych dlzok operandov, preto nie su rozvinute ako pri +, -, *
+    quotient = {};
+    remainder = {};
 
-        // Odstranenie zbytocnych 0 z konca vektora
-        while (storage.back() == 0) {
-            storage.pop_back();
-        }
-        // Priradenie vysledneho vektora
-        this->numbers = std::move(storage);
-        
-        return *this;
-    };
+    // Efektivne dlzky delenca a delitela
+    size_t n = N;
+    while (n > 0 && v[n-1] == 0) { n--; }
+    if (n == 0) {
+        throw std::runtime_error("Dividing by 0!");
+    }
+    size_t m = M;
+    while (m > 0 && u[m-1] == 0) { m--; }
 
-    BigInteger& operator/=(const BigInteger& rhs) {
-        // Ak A/0
-        if (rhs.zero) {
-            throw std::runtime_error("Dividing by 0!");
+    // Ak A < B podla poctu limbov, vysledok je 0 a zvysok A
+    if (m < n) {
+        for (size_t i = 0; i < m; i++) {
+            remainder[i] = u[i];
         }
-        // Ak 0/B 
-        if (this->zero) {
-            return *this;
+        return;
+    }
+    // Delenie jednym limbom
+    if (n == 1) {
+        WideLimb rest = 0;
+        for (size_t i = m; i-- > 0;) {
+            WideLimb current = (rest << 64) | u[i];
+            quotient[i] = static_cast<uint64_t>(current / v[0]);
+            rest = current % v[0];
         }
-        
-        // // Nastvanenie spravneho znamienka
-        // this->negative = !(this->negative == rhs.negative);
+        remainder[0] = static_cast<uint64_t>(rest);
+        return;
+    }
 
-        // Ak A/1
-        if (IsOne(rhs)) {
-            return *this;
+    // Viac limbov; Pre N == 1 sa tato cast ani neinstancuje (indexy n-2 by boli mimo pola)
+    if constexpr (N >= 2) {
+        // Normalizacia, aby najvyssi bit delitela bol 1
+        int shift = std::countl_zero(v[n-1]);
+        std::array<uint64_t, N> vn{};
+        std::array<uint64_t, M + 1> un{};
+        for (size_t i = n - 1; i > 0; i--) {
+            vn[i] = (v[i] << shift) | (shift ? (v[i-1] >> (64 - shift)) : 0);
         }
-        // Ak A/B, kde A = B, ich vektory
-        if (EqualVectors(*this, rhs)) {
-            this->numbers = {1};
-            return *this;
+        vn[0] = v[0] << shift;
+        un[m] = shift ? (u[m-1] >> (64 - shift)) : 0;
+        for (size_t i = m - 1; i > 0; i--) {
+            un[i] = (u[i] << shift) | (shift ? (u[i-1] >> (64 - shift)) : 0);
         }
-        // Ak A/B, kde A < B
-        if (*this < rhs) {
-            SetToZero(*this);
-            return *this;
+        un[0] = u[0] << shift;
+
+        const WideLimb base = static_cast<WideLimb>(1) << 64;
+        for (size_t j = m - n + 1; j-- > 0;) {
+            // Odhad cifry podielu z dvoch najvyssich limbov
+            WideLimb numerator = (static_cast<WideLimb>(un[j+n]) << 64) | un[j+n-1];
+            WideLimb qhat = numerator / vn[n-1];
+            WideLimb rhat = numerator % vn[n-1];
+            while ((qhat >= base) || (qhat * vn[n-2] > ((rhat << 64) | un[j+n-2]))) {
+                qhat--;
+                rhat += vn[n-1];
+                if (rhat >= base) { break; }
+            }
+
+            // Odcitanie qhat * delitel od aktualnej casti delenca
+            uint64_t carrying = 0;
+            uint64_t taking = 0;
+            for (size_t i = 0; i < n; i++) {
+                WideLimb product = qhat * vn[i] + carrying;
+                carrying = static_cast<uint64_t>(product >> 64);
+                uint64_t low = static_cast<uint64_t>(product);
+                uint64_t difference = un[i+j] - low;
+                uint64_t taken = (un[i+j] < low);
+                taken += (difference < taking);
+                un[i+j] = difference - taking;
+                taking = taken;
+            }
+            uint64_t difference = un[j+n] - carrying;
+            bool negative = (un[j+n] < carrying) || (difference < taking);
+            un[j+n] = difference - taking;
+
+            // Odhad bol o 1 vacsi; Pripocitanie delitela naspat
+            if (negative) {
+                qhat--;
+                uint64_t carry = 0;
+                for (size_t i = 0; i < n; i++) {
+                    WideLimb sum = static_cast<WideLimb>(un[i+j]) + vn[i] + carry;
+                    un[i+j] = static_cast<uint64_t>(sum);
+                    carry = static_cast<uint64_t>(sum >> 64);
+                }
+                un[j+n] += carry;
+            }
+            quotient[j] = static_cast<uint64_t>(qhat);
+        }
+
+        // Denormalizacia zvysku
+        for (size_t i = 0; i < n; i++) {
+            remainder[i] = (un[i] >> shift) | (shift ? (un[i+1] << (64 - shift)) : 0);
         }
+    }
+}
 
-        // // Ulozenie znamienka a zmena na 'false' (kladne)
-        // bool this_negative = this->negative;
-        // this->negative = false;
+template <size_t Bits>
+class FixedBigUInt
+{
+    static_assert(Bits > 0 && Bits % 64 == 0, "FixedBigUInt width must be a positive multiple of 64!");
 
-        // // Presun vysledku a spravne nastavenie 'this' parametrov
-        // this->negative = this->zero ? false : this_negative;
+public:
+    static constexpr size_t LIMBS = Bits / 64;
 
-        DivisionModuloLogic(*this, rhs, true);
+    // constructors
+    constexpr FixedBigUInt()
+        : limbs{}
+    {}
 
-        return *this;
-    };
+    constexpr FixedBigUInt(uint64_t n)
+        : limbs{}
+    {
+        this->limbs[0] = n;
+    }
 
-    BigInteger& operator%=(const BigInteger& rhs) {
-        // Ak A%0
-        if (rhs.zero) {
-            throw std::runtime_error("Modulling by 0!");
+    constexpr explicit FixedBigUInt(const BigInteger& biginteger)
+        : limbs{}
+    {
+        if (GetNegative(biginteger)) {
+            throw std::runtime_error("Negative BigInteger in FixedBigUInt!");
         }
-        // Ak 0%B 
-        if (this->zero) {
-            return *this;
+        *this = FromMagnitude(biginteger);
+    }
+
+    // conversion
+    constexpr BigInteger to_biginteger() const {
+        BigInteger converted;
+        // Ak 0
+        if (this->is_zero()) {
+            return converted;
         }
-        // Ak A%1 alebo A%B, kde A = B, ich vektory
-        if (IsOne(rhs) || EqualVectors(*this, rhs)) {
-            SetToZero(*this);
-            return *this;
+        converted.numbers.clear();
+        converted.zero = false;
+
+        // Opakovane delenie cislom MODULO; Zvysky su priamo limby BigInteger
+        FixedBigUInt rest = *this;
+        while (!rest.is_zero()) {
+            converted.numbers.push_back(rest.DivideSmall(MODULO));
         }
-        // Ak A%B, kde A < B
-        if (*this < rhs) {
-            return *this;
+        return converted;
+    }
+
+    constexpr bool is_zero() const {
+        for (size_t i = 0; i < LIMBS; i++) {
+            if (this->limbs[i] != 0) { return false; }
         }
+        return true;
+    }
 
-        DivisionModuloLogic(*this, rhs, false);
+    constexpr size_t bit_length() const {
+        for (size_t i = LIMBS; i-- > 0;) {
+            if (this->limbs[i] != 0) {
+                return (i * 64) + (64 - std::countl_zero(this->limbs[i]));
+            }
+        }
+        return 0;
+    }
 
-        return *this;
-    };
+    constexpr bool bit(size_t index) const {
+        return (this->limbs[index / 64] >> (index % 64)) & 1;
+    }
 
-    // sqrt
-    double sqrt() const {
-        // Ak zaporne cislo
-        if (this->negative) {
-            throw std::runtime_error("No SQRT of negative BigInteger");
-        }
-        // Ak sqrt(0)
-        if (this->zero) {
-            return 0;
-        }
-        // Ak sqrt(1)
-        if (IsOne(*this)) {
-            return 1;
+    constexpr const std::array<uint64_t, LIMBS>& data() const {
+        return this->limbs;
+    }
+
+
+    // unary operators
+    constexpr FixedBigUInt operator-() const {
+        // Dvojkovy doplnok: ~A + 1
+        FixedBigUInt negated;
+        for (size_t i = 0; i < LIMBS; i++) {
+            negated.limbs[i] = ~this->limbs[i];
         }
+        negated += FixedBigUInt(1);
+        return negated;
+    }
+
+
+    // binary arithmetics operators
+    constexpr FixedBigUInt& operator+=(const FixedBigUInt& rhs) {
+        AddLimbs(rhs, std::make_index_sequence<LIMBS>{});
+        return *this;
+    }
+
+    constexpr FixedBigUInt& operator-=(const FixedBigUInt& rhs) {
+        SubtractLimbs(rhs, std::make_index_sequence<LIMBS>{});
+        return *this;
+    }
+
+    constexpr FixedBigUInt& operator*=(const FixedBigUInt& rhs) {
+        std::array<uint64_t, LIMBS> storage{};
+        MultiplyRows<LIMBS>(storage, this->limbs, rhs.limbs, std::make_index_sequence<LIMBS>{});
+        this->limbs = storage;
+        return *this;
+    }
+
+    constexpr FixedBigUInt& operator/=(const FixedBigUInt& rhs) {
+        *this = divmod(*this, rhs).first;
+        return *this;
+    }
 
-        return std::sqrt(ConvertToDouble(*this));
-    };
+    constexpr FixedBigUInt& operator%=(const FixedBigUInt& rhs) {
+        *this = divmod(*this, rhs).second;
+        return *this;
+    }
 
-#if SUPPORT_MORE_OPS == 1
-    BigInteger isqrt() const {
-        // Ak zaporne cislo
-        if (this->negative) {
-            throw std::runtime_error("No SQRT of negative BigInteger");
-        }
-        // Ak 0 alebo 1
-        if (this->zero || IsOne(*this)) {
+    constexpr FixedBigUInt& operator<<=(size_t shift) {
+        if (shift >= Bits) {
+            this->limbs = {};
             return *this;
         }
- 
-        BigInteger guess = (*this / 2);
-        BigInteger value;
-
-        while (true) {
-            // Newton method
-            value = ((guess + (*this / guess)) / 2);
-
-            // Overenie dosiahnutia hranice
-            if ((guess == value) || ((guess+1) == value) || ((guess-1) == value)) {
-                break;
+        size_t limb_shift = shift / 64;
+        size_t bit_shift = shift % 64;
+        for (size_t i = LIMBS; i-- > 0;) {
+            uint64_t value = (i >= limb_shift) ? (this->limbs[i - limb_shift] << bit_shift) : 0;
+            if (bit_shift && i >= limb_shift + 1) {
+                value |= this->limbs[i - limb_shift - 1] >> (64 - bit_shift);
             }
-            guess = value;
+            this->limbs[i] = value;
         }
+        return *this;
+    }
 
-        // Ak vacsie, potreba odcitat -1
-        if ((value * value) > *this)
-            value -= 1;
-
-        return value;
-    };
-
-    bool is_prime(size_t k) const { // use rabbin-miller test with k rounds
-        // Cisla: 0, 1, zaporne nie su PRIME
-        if (this->zero || IsOne(*this) || this->negative) {
-            return false;
-        }
-        // Ak 2 alebo 3
-        if (this->numbers.size() == 1 && ((this->numbers[0] == 2) || (this->numbers[0] == 3))) {
-            return true;
+    constexpr FixedBigUInt& operator>>=(size_t shift) {
+        if (shift >= Bits) {
+            this->limbs = {};
+            return *this;
         }
-        // Parne cislo nie je PRIME
-        if ((*this % 2) == 0) {
-            return false;
+        size_t limb_shift = shift / 64;
+        size_t bit_shift = shift % 64;
+        for (size_t i = 0; i < LIMBS; i++) {
+            uint64_t value = (i + limb_shift < LIMBS) ? (this->limbs[i + limb_shift] >> bit_shift) : 0;
+            if (bit_shift && i + limb_shift + 1 < LIMBS) {
+                value |= this->limbs[i + limb_shift + 1] << (64 - bit_shift);
+            }
+            this->limbs[i] = value;
         }
+        return *this;
+    }
 
-        BigInteger d = (*this - BigInteger(1));
-        size_t s = 0;
+    static constexpr std::pair<FixedBigUInt, FixedBigUInt> divmod(const FixedBigUInt& lhs, const FixedBigUInt& rhs) {
+        // Ak A/0
+        if (rhs.is_zero()) {
+            throw std::runtime_error("Dividing by 0!");
+        }
+        std::pair<FixedBigUInt, FixedBigUInt> result;
+        FixedDivideLimbs<LIMBS, LIMBS>(lhs.limbs, rhs.limbs, result.first.limbs, result.second.limbs);
+        return result;
+    }
 
-        while((d % 2) == 0) {
-            s++;
-            d /= BigInteger(2);
+    static constexpr FixedBigUInt mulmod(const FixedBigUInt& a, const FixedBigUInt& b, const FixedBigUInt& mod) {  // Compute a*b % mod
+        // Ak A%0
+        if (mod.is_zero()) {
+            throw std::runtime_error("Modulling by 0!");
         }
+        // Plny sucin ma 2*LIMBS limbov, preto netreba sirsi typ
+        std::array<uint64_t, 2 * LIMBS> product{};
+        MultiplyRows<2 * LIMBS>(product, a.limbs, b.limbs, std::make_index_sequence<LIMBS>{});
+
+        std::array<uint64_t, 2 * LIMBS> quotient{};
+        FixedBigUInt remainder;
+        FixedDivideLimbs<2 * LIMBS, LIMBS>(product, mod.limbs, quotient, remainder.limbs);
+        return remainder;
+    }
 
-        for (size_t test = 0; test < k; test++) {
-            
-            BigInteger a = PickRandomBigInteger(ToString(*this - BigInteger(2)));
-            BigInteger x = modpow(a, d, *this);
-            
-            for (size_t i = 0; i < s; i++) {
-                BigInteger y = modmult(x, x, *this);
-                if ((y == BigInteger(1)) && (x != BigInteger(1)) && (x != (*this - BigInteger(1)))) {
-                    return false;
-                }
-                x = y;
-            }
-            if (x != BigInteger(1)) {
-                return false;
+    static constexpr FixedBigUInt modpow(FixedBigUInt base, const FixedBigUInt& exp, const FixedBigUInt& mod) {  // Compute base^exp % mod
+        // Ak A%0
+        if (mod.is_zero()) {
+            throw std::runtime_error("Modulling by 0!");
+        }
+        FixedBigUInt result = FixedBigUInt(1) % mod;
+        base %= mod;
+
+        // Zlava doprava cez bity exponentu
+        for (size_t i = exp.bit_length(); i-- > 0;) {
+            result = mulmod(result, result, mod);
+            if (exp.bit(i)) {
+                result = mulmod(result, base, mod);
             }
         }
-        
-        return true;
-    }; 
-#endif
+        return result;
+    }
 
 private:
-    std::vector<uint64_t> numbers;
-    bool negative;
-    bool zero;
+    std::array<uint64_t, LIMBS> limbs;
+
+    static constexpr FixedBigUInt FromMagnitude(const BigInteger& biginteger) {
+        FixedBigUInt converted;
+        // Hornerova schema od najvyssieho limbu: X = X * MODULO + limb
+        for (auto iterator = biginteger.numbers.rbegin(); iterator != biginteger.numbers.rend(); iterator++) {
+            uint64_t carrying = *iterator;
+            for (size_t i = 0; i < LIMBS; i++) {
+                WideLimb total = static_cast<WideLimb>(converted.limbs[i]) * MODULO + carrying;
+                converted.limbs[i] = static_cast<uint64_t>(total);
+                carrying = static_cast<uint64_t>(total >> 64);
+            }
+            // Pretecenie sirky
+            if (carrying != 0) {
+                throw std::runtime_error("BigInteger too big for FixedBigUInt!");
+            }
+        }
+        return converted;
+    }
 
-    std::string ToString(const BigInteger& biginteger) const {
-        std::ostringstream oss;
-        oss << biginteger.numbers.back();
-        for (int64_t i = biginteger.numbers.size() - 2; i >= 0; i--) {
-            oss << std::setw(9) << std::setfill('0') << biginteger.numbers[i];
+    constexpr uint64_t DivideSmall(uint64_t divisor) {
+        // Delenie jednym limbom na mieste, vrati zvysok
+        WideLimb rest = 0;
+        for (size_t i = LIMBS; i-- > 0;) {
+            WideLimb current = (rest << 64) | this->limbs[i];
+            this->limbs[i] = static_cast<uint64_t>(current / divisor);
+            rest = current % divisor;
         }
-        return oss.str();
+        return static_cast<uint64_t>(rest);
     }
 
-    BigInteger PickRandomBigInteger(const std::string& NUM) const {
-        std::random_device rd;
-        std::mt19937 gen(rd());
+    // Rozvinute slucky: pocet krokov je znamy v case kompilacie, fold cez index_sequence
+    template <size_t... I>
+    constexpr void AddLimbs(const FixedBigUInt& rhs, std::index_sequence<I...>) {
+        uint64_t carrying = 0;
+        (AddStep(this->limbs[I], rhs.limbs[I], carrying), ...);
+    }
 
-        // Nahodne sa vyberie pocet cifier (1 az NUM)
-        std::uniform_int_distribution<int32_t> lengthDist(1, NUM.length());
-        size_t numDigits = lengthDist(gen);
+    template <size_t... I>
+    constexpr void SubtractLimbs(const FixedBigUInt& rhs, std::index_sequence<I...>) {
+        uint64_t taking = 0;
+        (SubtractStep(this->limbs[I], rhs.limbs[I], taking), ...);
+    }
 
-        std::string result;
+    static constexpr void AddStep(uint64_t& a, uint64_t b, uint64_t& carrying) {
+        uint64_t sum = a + b;
+        uint64_t carry = (sum < a);
+        sum += carrying;
+        carry += (sum < carrying);
+        a = sum;
+        carrying = carry;
+    }
 
-        // Vyber cifier
-        for (size_t i = 0; i < numDigits; i++) {
-            int32_t maxDigit = ((numDigits == NUM.length()) && (result == NUM.substr(0, i))) ? NUM[i] - '0' : 9;
-            std::uniform_int_distribution<int32_t> nextDigit((i == 0) ? 1 : 0, maxDigit);
-            result += ('0' + nextDigit(gen));
-        }
-        // Minimum musi byt 2
-        if (result < std::string("2")) {
-            result = "2";
-        }
+    static constexpr void SubtractStep(uint64_t& a, uint64_t b, uint64_t& taking) {
+        uint64_t difference = a - b;
+        uint64_t taken = (a < b);
+        taken += (difference < taking);
+        a = difference - taking;
+        taking = taken;
+    }
 
-        return BigInteger(result);
+    static constexpr void MultiplyStep(uint64_t& storage, uint64_t a, uint64_t b, uint64_t& carrying) {
+        WideLimb total = static_cast<WideLimb>(a) * b + storage + carrying;
+        storage = static_cast<uint64_t>(total);
+        carrying = static_cast<uint64_t>(total >> 64);
     }
 
-    BigInteger modmult(BigInteger a, BigInteger b, const BigInteger& mod) const {  // Compute a*b % mod
-        BigInteger result(0);
-        while (b > BigInteger(0)) {
-            if ((b % BigInteger(2)) == BigInteger(1)) {
-                result = (result + a) % mod;
-            }
-            a = (a + a) % mod;
-            b /= BigInteger(2);
+    template <size_t OUT, size_t ROW, size_t... J>
+    static constexpr void MultiplyRow(std::array<uint64_t, OUT>& storage, uint64_t a, const std::array<uint64_t, LIMBS>& b, std::index_sequence<J...>) {
+        // Nasobenie 0-lou nema ziadny efekt na vysledok
+        if (a == 0) { return; }
+        uint64_t carrying = 0;
+        (MultiplyStep(storage[ROW + J], a, b[J], carrying), ...);
+        // Prenos ide na este nepouzity limb (ak sa vysledok neorezava)
+        if constexpr (ROW + sizeof...(J) < OUT) {
+            storage[ROW + sizeof...(J)] = carrying;
         }
-        return result;
     }
 
-    BigInteger modpow(BigInteger& a, BigInteger& b, const BigInteger& mod) const {  // Compute a^b % mod
-        BigInteger result(1);
-        while (b > BigInteger(0)) {
-            if ((b % BigInteger(2)) == BigInteger(1)) {
-                result = modmult(result, a, mod);
-            }
-            a = modmult(a, a, mod);
-            b /= BigInteger(2);
-        }
-        return result;
+    template <size_t OUT, size_t... I>
+    static constexpr void MultiplyRows(std::array<uint64_t, OUT>& storage, const std::array<uint64_t, LIMBS>& a, const std::array<uint64_t, LIMBS>& b, std::index_sequence<I...>) {
+        (MultiplyRow<OUT, I>(storage, a[I], b, std::make_index_sequence<std::min(LIMBS, OUT - I)>{}), ...);
     }
 
-    friend inline BigInteger operator+(BigInteger lhs, const BigInteger& rhs);
-    friend inline BigInteger operator-(BigInteger lhs, const BigInteger& rhs);
-    friend inline BigInteger operator*(BigInteger lhs, const BigInteger& rhs);
-    friend inline BigInteger operator/(BigInteger lhs, const BigInteger& rhs);
-    friend inline BigInteger operator%(BigInteger lhs, const BigInteger& rhs);
+    friend constexpr FixedBigUInt operator+(FixedBigUInt lhs, const FixedBigUInt& rhs) { lhs += rhs; return lhs; }
+    friend constexpr FixedBigUInt operator-(FixedBigUInt lhs, const FixedBigUInt& rhs) { lhs -= rhs; return lhs; }
+    friend constexpr FixedBigUInt operator*(FixedBigUInt lhs, const FixedBigUInt& rhs) { lhs *= rhs; return lhs; }
+    friend constexpr FixedBigUInt operator/(FixedBigUInt lhs, const FixedBigUInt& rhs) { lhs /= rhs; return lhs; }
+    friend constexpr FixedBigUInt operator%(FixedBigUInt lhs, const FixedBigUInt& rhs) { lhs %= rhs; return lhs; }
+    friend constexpr FixedBigUInt operator<<(FixedBigUInt lhs, size_t shift) { lhs <<= shift; return lhs; }
+    friend constexpr FixedBigUInt operator>>(FixedBigUInt lhs, size_t shift) { lhs >>= shift; return lhs; }
 
-    friend inline bool operator==(const BigInteger& lhs, const BigInteger& rhs);
-    friend inline bool operator!=(const BigInteger& lhs, const BigInteger& rhs);
-    friend inline bool operator<(const BigInteger& lhs, const BigInteger& rhs);
-    friend inline bool operator>(const BigInteger& lhs, const BigInteger& rhs);
-    friend inline bool operator<=(const BigInteger& lhs, const BigInteger& rhs);
-    friend inline bool operator>=(const BigInteger& lhs, const BigInteger& rhs);
-    friend std::ostream& operator<<(std::ostream& lhs, const BigInteger& rhs);
+    friend constexpr bool operator==(const FixedBigUInt& lhs, const FixedBigUInt& rhs) {
+        return (lhs.limbs == rhs.limbs);
+    }
+    friend constexpr bool operator!=(const FixedBigUInt& lhs, const FixedBigUInt& rhs) {
+        return !(lhs == rhs);
+    }
+    friend constexpr bool operator<(const FixedBigUInt& lhs, const FixedBigUInt& rhs) {
+        // Porovnanie od najvyssieho limbu
+        for (size_t i = LIMBS; i-- > 0;) {
+            if (lhs.limbs[i] != rhs.limbs[i]) {
+                return (lhs.limbs[i] < rhs.limbs[i]);
+            }
+        }
+        return false;
+    }
+    friend constexpr bool operator>(const FixedBigUInt& lhs, const FixedBigUInt& rhs) {
+        return (rhs < lhs);
+    }
+    friend constexpr bool operator<=(const FixedBigUInt& lhs, const FixedBigUInt& rhs) {
+        return !(lhs > rhs);
+    }
+    friend constexpr bool operator>=(const FixedBigUInt& lhs, const FixedBigUInt& rhs) {
+        return !(lhs < rhs);
+    }
+    friend std::ostream& operator<<(std::ostream& os, const FixedBigUInt& rhs) {
+        return (os << rhs.to_biginteger());
+    }
 
-    friend void DivisionModuloLogic(BigInteger& lhs, const BigInteger& rhs, bool divison);
-    friend inline bool EqualVectors(const BigInteger& lhs, const BigInteger& rhs);
-    friend inline void SetToZero(BigInteger& biginteger);
-    friend inline void SetToOne(BigInteger& biginteger);
-    friend inline bool IsOne(const BigInteger& biginteger);
-    friend inline bool GetNegative(const BigInteger& biginteger);
-    friend inline void SetNegative(BigInteger& biginteger, bool value);
-    friend inline bool GetZero(const BigInteger& biginteger);
-    friend inline double ConvertToDouble(const BigInteger& biginteger);
+    friend class FixedBigInt<Bits>;
 };
 
-inline BigInteger operator+(BigInteger lhs, const BigInteger& rhs) { lhs += rhs; return lhs; };
-inline BigInteger operator-(BigInteger lhs, const BigInteger& rhs) { lhs -= rhs; return lhs; };
-inline BigInteger operator*(BigInteger lhs, const BigInteger& rhs) { lhs *= rhs; return lhs; };
-inline BigInteger operator/(BigInteger lhs, const BigInteger& rhs) { lhs /= rhs; return lhs; };
-inline BigInteger operator%(BigInteger lhs, const BigInteger& rhs) { lhs %= rhs; return lhs; };
+template <size_t Bits>
+class FixedBigInt
+{
+public:
+    static constexpr size_t LIMBS = FixedBigUInt<Bits>::LIMBS;
 
-inline bool operator==(const BigInteger& lhs, const BigInteger& rhs) {
-    // Znamienka sa musia rovnat; Takisto vsetky cisla vo vektore a ich pocet sa musia rovnat
-    return ((lhs.negative == rhs.negative) && (lhs.numbers == rhs.numbers));
-};
-inline bool operator!=(const BigInteger& lhs, const BigInteger& rhs) {
-    // Spravime negaciu, cize 'lhs' sa musi rovnat 'rhs'; Samotna negacia musi byt znegovana, aby to platilo.
-    return !(lhs == rhs);
-};
-inline bool operator<(const BigInteger& lhs, const BigInteger& rhs) {
-    // Rozne znamienka; Samotna hodnota lhs.negative hovori vysledok
-    if (lhs.negative != rhs.negative) {
-        return lhs.negative;
+    // constructors
+    constexpr FixedBigInt()
+        : bits()
+    {}
+
+    constexpr FixedBigInt(int64_t n)
+        : bits(static_cast<uint64_t>(n))
+    {
+        // Rozsirenie znamienka do vyssich limbov
+        if (n < 0) {
+            for (size_t i = 1; i < LIMBS; i++) {
+                this->bits.limbs[i] = ~static_cast<uint64_t>(0);
+            }
+        }
     }
 
-    // Rovnake znamienka; Rozne velkosti vektorov
-    if (lhs.numbers.size() != rhs.numbers.size()) {
-        // Ak cisla ZAPORNE, tak velkost vektora 'lhs' musi byt vacsia
-        if (lhs.negative) {
-            return (lhs.numbers.size() > rhs.numbers.size());
+    constexpr explicit FixedBigInt(const FixedBigUInt<Bits>& value)
+        : bits(value)
+    {}
+
+    constexpr explicit FixedBigInt(const BigInteger& biginteger)
+        : bits(FixedBigUInt<Bits>::FromMagnitude(biginteger))
+    {
+        // Najvyssi bit je znamienkovy; Velkost musi byt mensia ako 2^(Bits-1)
+        bool negative = GetNegative(biginteger);
+        if (this->bits.bit(Bits - 1) && !(negative && this->bits == (FixedBigUInt<Bits>(1) << (Bits - 1)))) {
+            throw std::runtime_error("BigInteger too big for FixedBigInt!");
         }
-        // Ak cisla KLADNE, tak velkost vektora 'lhs' musi byt mensia
-        else {
-            return (lhs.numbers.size() < rhs.numbers.size());
+        if (negative) {
+            this->bits = -this->bits;
         }
     }
 
-    // Rovnake znamienka; Rovnake velkosti vektorov
-    for (int64_t i = lhs.numbers.size() - 1; i >= 0; i--) {
-        // Ak su cisla rozne
-        if (lhs.numbers[i] != rhs.numbers[i]) {
-            // Ak cisla ZAPORNE, tak 'lhs' cislo musi byt vacsie
-            if (lhs.negative) {
-                return (lhs.numbers[i] > rhs.numbers[i]);
-            }
-            // Ak cisla KLADNE, tak 'lhs' cislo musi byt mensie
-            else {
-                return (lhs.numbers[i] < rhs.numbers[i]);
-            }
+    // conversion
+    constexpr BigInteger to_biginteger() const {
+        if (!this->is_negative()) {
+            return this->bits.to_biginteger();
         }
+        BigInteger converted = (-this->bits).to_biginteger();
+        SetNegative(converted, true);
+        return converted;
     }
 
-    return false;
-};
-inline bool operator>(const BigInteger& lhs, const BigInteger& rhs) {
-    // Ak 'lhs' ma byt vacsie ako 'rhs', tak potom 'rhs' musi byt mensie ako 'lhs'
-    return (rhs < lhs);
-};
-inline bool operator<=(const BigInteger& lhs, const BigInteger& rhs) {
-    // Spravime negaciu, cize 'lhs' musi byt vacsie ako 'rhs'; Samotna negacia musi byt znegovana, aby to platilo.
-    return !(lhs > rhs);
-};
-inline bool operator>=(const BigInteger& lhs, const BigInteger& rhs) {
-    // Spravime negaciu, cize 'lhs' musi byt mensie ako 'rhs'; Samotna negacia musi byt znegovana, aby to platilo.
-    return !(lhs < rhs);
-};
-inline std::ostream& operator<<(std::ostream& os, const BigInteger& rhs) {
-    // Ak cislo je 0
-    if (rhs.zero) {
-        os << 0;
-        return os;
-    }
-    // Ak cislo zaporne, tak vypis znamienka
-    if (rhs.negative) {
-        os << '-';
+    constexpr bool is_negative() const {
+        return this->bits.bit(Bits - 1);
     }
-    // Ak cislo je 1
-    if (IsOne(rhs)) {
-        os << 1;
-        return os;
+
+    constexpr bool is_zero() const {
+        return this->bits.is_zero();
     }
 
-    // Posledna, respektive prva cast cisla sa vypise bez prefixovych 0-ul
-    os << rhs.numbers.back();
-    // Vsetky dalsie casti cisla na vypise aj s prefixovymi 0-mi
-    for (int64_t i = rhs.numbers.size() - 2; i >= 0; i--) {
-        os << std::setw(9) << std::setfill('0') << rhs.numbers[i];
+    constexpr FixedBigUInt<Bits> magnitude() const {
+        return this->is_negative() ? -this->bits : this->bits;
     }
 
-    return os;
-};
+    constexpr const FixedBigUInt<Bits>& raw() const {
+        return this->bits;
+    }
 
-void DivisionModuloLogic(BigInteger& lhs, const BigInteger& rhs, bool divison) {
-    // Vytvorenie konstanty pre nasobenie, buduceho vysledku
-    BigInteger constant(2);
-    BigInteger answer;
-
-    // Kedze toto je implementacia delenia/modula, hodnoty treba uchovat do vektora, aby sa k nim mohlo vratit
-    // Pridanie kopie 'rhs' do vektora
-    std::vector<BigInteger> denom;
-    denom.reserve(5);
-    denom.push_back(rhs);
-    //denom[0].negative = false;
-    
-    // Priame vytvorenie objektu do vektora
-    std::vector<BigInteger> current;
-    current.reserve(5);
-    current.emplace_back(1);
 
-    int64_t index = 0;
-    // Ukladanie hodnot 'denom' a 'current' az do platnosti podmienky
-    while (denom[index] <= lhs) {
-        denom.push_back(constant * denom[index]);
-        current.push_back(constant * current[index]);
-        index++;
+    // unary operators
+    constexpr FixedBigInt operator-() const {
+        return FixedBigInt(-this->bits);
     }
-    index--;
 
-    // Proces pocitania vysledku a zvysku zaroven
-    while (index >= 0) {
-        if (lhs >= denom[index]) {
-            lhs -= denom[index];
-            answer += current[index];
-        }
-        index--;
-    }
 
-    // Presun vektora ak ide o /; Pri % je vysledok uz priamo ulozeny v 'this'
-    if (divison) {
-        lhs.numbers = std::move(answer.numbers);
+    // binary arithmetics operators
+    // Scitanie, odcitanie a nasobenie su v dvojkovom doplnku zhodne s unsigned
+    constexpr FixedBigInt& operator+=(const FixedBigInt& rhs) {
+        this->bits += rhs.bits;
+        return *this;
     }
-    // Nastavenie 'zero' pre oba pripady
-    lhs.zero = (lhs.numbers.size() == 1 && lhs.numbers[0] == 0);
 
-    return;
-}
+    constexpr FixedBigInt& operator-=(const FixedBigInt& rhs) {
+        this->bits -= rhs.bits;
+        return *this;
+    }
 
-inline bool EqualVectors(const BigInteger& lhs, const BigInteger& rhs) {
-    return (lhs.numbers == rhs.numbers);
-}
+    constexpr FixedBigInt& operator*=(const FixedBigInt& rhs) {
+        this->bits *= rhs.bits;
+        return *this;
+    }
 
-inline void SetToZero(BigInteger& biginteger) {
-    biginteger.numbers = {0};
-    biginteger.negative = false;
-    biginteger.zero = true;
-}
+    constexpr FixedBigInt& operator/=(const FixedBigInt& rhs) {
+        *this = divmod(*this, rhs).first;
+        return *this;
+    }
 
-inline void SetToOne(BigInteger& biginteger) {
-    biginteger.numbers = {1};
-    biginteger.negative = false;
-    biginteger.zero = false;
-}
+    constexpr FixedBigInt& operator%=(const FixedBigInt& rhs) {
+        *this = divmod(*this, rhs).second;
+        return *this;
+    }
 
-inline bool IsOne(const BigInteger& biginteger) {
-    return ((biginteger.numbers.size() == 1) && (biginteger.numbers[0] == 1));
-}
+    static constexpr std::pair<FixedBigInt, FixedBigInt> divmod(const FixedBigInt& lhs, const FixedBigInt& rhs) {
+        // Delenie s orezanim k 0 ako pri int; Zvysok ma znamienko delenca
+        auto [quotient, remainder] = FixedBigUInt<Bits>::divmod(lhs.magnitude(), rhs.magnitude());
+        if (lhs.is_negative() != rhs.is_negative()) {
+            quotient = -quotient;
+        }
+        if (lhs.is_negative()) {
+            remainder = -remainder;
+        }
+        return {FixedBigInt(quotient), FixedBigInt(remainder)};
+    }
 
-inline bool GetNegative(const BigInteger& biginteger) {
-    return biginteger.negative;
-}
+    static constexpr FixedBigInt modpow(const FixedBigInt& base, const FixedBigInt& exp, const FixedBigInt& mod) {  // Compute base^exp % mod
+        if (exp.is_negative() || mod.is_negative() || mod.is_zero()) {
+            throw std::runtime_error("FixedBigInt modpow needs non-negative exponent and positive modulus!");
+        }
+        // Zaklad sa prevedie do intervalu <0, mod)
+        FixedBigUInt<Bits> reduced = base.magnitude() % mod.bits;
+        if (base.is_negative() && !reduced.is_zero()) {
+            reduced = mod.bits - reduced;
+        }
+        return FixedBigInt(FixedBigUInt<Bits>::modpow(reduced, exp.bits, mod.bits));
+    }
 
-inline void SetNegative(BigInteger& biginteger, bool value) {
-    biginteger.negative = value;
-}
+private:
+    FixedBigUInt<Bits> bits;
 
-inline bool GetZero(const BigInteger& biginteger) {
-    return biginteger.zero;
-}
+    friend constexpr FixedBigInt operator+(FixedBigInt lhs, const FixedBigInt& rhs) { lhs += rhs; return lhs; }
+    friend constexpr FixedBigInt operator-(FixedBigInt lhs, const FixedBigInt& rhs) { lhs -= rhs; return lhs; }
+    friend constexpr FixedBigInt operator*(FixedBigInt lhs, const FixedBigInt& rhs) { lhs *= rhs; return lhs; }
+    friend constexpr FixedBigInt operator/(FixedBigInt lhs, const FixedBigInt& rhs) { lhs /= rhs; return lhs; }
+    friend constexpr FixedBigInt operator%(FixedBigInt lhs, const FixedBigInt& rhs) { lhs %= rhs; return lhs; }
 
-inline double ConvertToDouble(const BigInteger& biginteger) {
-    double converted = 0;
-    // Overenie overflowu pre kazde cislo a nasledna konverzia na double
-    for (auto iterator = biginteger.numbers.rbegin(); iterator != biginteger.numbers.rend(); iterator++) {
-        if (((converted * MODULO) + *iterator) > std::numeric_limits<double>::max()) {
-            throw std::runtime_error("BigInteger too big!");
+    friend constexpr bool operator==(const FixedBigInt& lhs, const FixedBigInt& rhs) {
+        return (lhs.bits == rhs.bits);
+    }
+    friend constexpr bool operator!=(const FixedBigInt& lhs, const FixedBigInt& rhs) {
+        return !(lhs == rhs);
+    }
+    friend constexpr bool operator<(const FixedBigInt& lhs, const FixedBigInt& rhs) {
+        // Rozne znamienka; Samotna hodnota lhs.is_negative() hovori vysledok
+        if (lhs.is_negative() != rhs.is_negative()) {
+            return lhs.is_negative();
         }
-        converted = (converted * MODULO) + *iterator;
+        // Rovnake znamienka; V dvojkovom doplnku staci porovnat bez znamienka
+        return (lhs.bits < rhs.bits);
     }
-    return converted;
-}
-
-
-#if SUPPORT_IFSTREAM == 1
-// this should behave exactly the same as reading int with respect to 
-// whitespace, consumed characters etc...
-inline std::istream& operator>>(std::istream& lhs, BigInteger& rhs); // bonus
-#endif
+    friend constexpr bool operator>(const FixedBigInt& lhs, const FixedBigInt& rhs) {
+        return (rhs < lhs);
+    }
+    friend constexpr bool operator<=(const FixedBigInt& lhs, const FixedBigInt& rhs) {
+        return !(lhs > rhs);
+    }
+    friend constexpr bool operator>=(const FixedBigInt& lhs, const FixedBigInt& rhs) {
+        return !(lhs < rhs);
+    }
+    friend std::ostream& operator<<(std::ostream& os, const FixedBigInt& rhs) {
+        return (os << rhs.to_biginteger());
+    }
+};
 
 
 class BigRational
@@ -994,9 +5249,6 @@ public:
     };
     
     BigRational& operator*=(const BigRational& rhs) {
-        // Nastavenie spravneho znamienka
-        this->negative = !(this->negative == rhs.negative);
-        
         // Ak 0*B
         if (GetZero(this->numerator)) {
             return *this;
@@ -1006,9 +5258,14 @@ public:
             SetToZeroR(*this);
             return *this;
         }
-        // Ak 1*B
+        // Nastavenie spravneho znamienka
+        this->negative = !(this->negative == rhs.negative);
+
+        // Ak 1*B; znamienko uz je nastavene
         if (IsOneR(*this)) {
+            bool negative = this->negative;
             *this = rhs;
+            this->negative = negative;
             return *this;
         }
         // Ak A*1
@@ -1047,17 +5304,98 @@ public:
             return *this;
         }
         // Ak A/B, kde na kriz sa zlomky A a B rovnaju; Znamienka sa tu neriesia
+        // (A/B) / (B/A) = A^2 / B^2, ktore uz je v zakladnom tvare
         if (EqualVectors(this->numerator, rhs.denominator) && EqualVectors(this->denominator, rhs.numerator)) {
+            this->numerator *= this->numerator;
+            this->denominator *= this->denominator;
+            return *this;
+        }
+
+        this->numerator *= rhs.denominator;
+        this->denominator *= rhs.numerator;
+
+        SimplifyNumber(*this);
+        return *this;
+    };
+
+    // mixed arithmetics with integers; the integer is n/1, no promotion to BigRational
+    BigRational& operator+=(const BigInteger& rhs) {
+        // (A + k*B) / B je stale v zakladnom tvare, NSD netreba
+        if (GetZero(rhs)) {
+            return *this;
+        }
+        BigInteger value = this->denominator * rhs;
+        if (this->negative) { value -= this->numerator; }
+        else { value += this->numerator; }
+        SetNumeratorR(*this, std::move(value));
+        return *this;
+    };
+
+    BigRational& operator-=(const BigInteger& rhs) {
+        if (GetZero(rhs)) {
+            return *this;
+        }
+        BigInteger value = this->denominator * -rhs;
+        if (this->negative) { value -= this->numerator; }
+        else { value += this->numerator; }
+        SetNumeratorR(*this, std::move(value));
+        return *this;
+    };
+
+    BigRational& operator*=(const BigInteger& rhs) {
+        // Ak 0*k alebo A*0
+        if (GetZero(this->numerator)) {
+            return *this;
+        }
+        if (GetZero(rhs)) {
+            SetToZeroR(*this);
+            return *this;
+        }
+        bool rhs_negative = (rhs < 0);
+        this->negative = (this->negative != rhs_negative);
+        BigInteger factor = rhs_negative ? -rhs : rhs;
+
+        // Kratit treba iba s menovatelom: NSD(k, B)
+        if (!IsOne(this->denominator)) {
+            BigInteger divisor = gcd(factor, this->denominator);
+            if (!IsOne(divisor)) {
+                factor /= divisor;
+                this->denominator /= divisor;
+            }
+        }
+        this->numerator *= factor;
+        return *this;
+    };
+
+    BigRational& operator/=(const BigInteger& rhs) {
+        // Ak A/0
+        if (GetZero(rhs)) {
+            throw std::runtime_error("Dividing by 0!");
+        }
+        if (GetZero(this->numerator)) {
             return *this;
         }
-
-        this->numerator *= rhs.denominator;
-        this->denominator *= rhs.numerator;
-
-        SimplifyNumber(*this);
+        bool rhs_negative = (rhs < 0);
+        this->negative = (this->negative != rhs_negative);
+        BigInteger factor = rhs_negative ? -rhs : rhs;
+
+        // Kratit treba iba s citatelom: NSD(A, k)
+        if (!IsOne(this->numerator)) {
+            BigInteger divisor = gcd(this->numerator, factor);
+            if (!IsOne(divisor)) {
+                factor /= divisor;
+                this->numerator /= divisor;
+            }
+        }
+        this->denominator *= factor;
         return *this;
     };
 
+    BigRational& operator+=(int64_t rhs) { return *this += BigInteger(rhs); };
+    BigRational& operator-=(int64_t rhs) { return *this -= BigInteger(rhs); };
+    BigRational& operator*=(int64_t rhs) { return *this *= BigInteger(rhs); };
+    BigRational& operator/=(int64_t rhs) { return *this /= BigInteger(rhs); };
+
     // sqrt
     double sqrt() const {
         // Ak zaporne cislo
@@ -1073,7 +5411,45 @@ public:
             return 1;
         }
         
-        return std::sqrt(ConvertToDouble(this->numerator) / ConvertToDouble(this->denominator));
+        // sqrt(m * 2^e) = sqrt(m) * 2^(e/2) pre parne e
+        auto [mantissa, exponent] = frexp(*this);
+        if (exponent & 1) {
+            mantissa *= 2;
+            exponent--;
+        }
+        if (exponent / 2 > std::numeric_limits<double>::max_exponent) {
+            throw std::runtime_error("BigRational too big!");
+        }
+        if (exponent / 2 < std::numeric_limits<double>::min_exponent - std::numeric_limits<double>::digits) {
+            return 0;
+        }
+        return std::ldexp(std::sqrt(mantissa), static_cast<int>(exponent / 2));
+    };
+
+    double to_double() const {  // correctly rounded (half to even), throws past the double range
+        if (GetZero(this->numerator)) {
+            return 0.0;
+        }
+        auto [significand, exponent] = RoundToDouble(*this, std::numeric_limits<double>::min_exponent - std::numeric_limits<double>::digits);
+        if (exponent + 53 > std::numeric_limits<double>::max_exponent) {
+            throw std::runtime_error("BigRational too big!");
+        }
+        // Pod najmensim subnormalnym cislom
+        if (significand == 0) {
+            return this->negative ? -0.0 : 0.0;
+        }
+        const double converted = std::ldexp(static_cast<double>(significand), static_cast<int>(exponent));
+        return this->negative ? -converted : converted;
+    };
+
+    // decimal expansion with a fixed number of fraction digits, from one scaled division
+    void write_decimal(std::ostream& os, size_t digits, RoundingMode mode = RoundingMode::Down) const;
+    std::string to_decimal_string(size_t digits, RoundingMode mode = RoundingMode::Down) const;
+
+    // hashing; the fraction is reduced, so equal values have equal numerators and denominators
+    size_t hash() const noexcept {
+        size_t value = (this->numerator.hash() * static_cast<size_t>(0x9E3779B97F4A7C15ull)) ^ this->denominator.hash();
+        return this->negative ? ~value : value;
     };
 
 #if SUPPORT_MORE_OPS == 1
@@ -1091,6 +5467,8 @@ public:
         BigInteger simple = (IsOne(this->denominator)) ? this->numerator : (this->numerator / this->denominator);
         return simple.isqrt();
     };
+
+    BigDecimal sqrt(size_t digits) const;  // sqrt truncated to 'digits' fraction digits, isqrt of A * 10^(2*digits) / B
 #endif
 
 private:
@@ -1114,6 +5492,17 @@ private:
     friend inline void SimplifyNumber(BigRational& bigrational);
     friend inline void SetToZeroR(BigRational& bigrational);
     friend inline bool IsOneR(const BigRational& bigrational);
+
+    friend inline BigRational operator/(const BigInteger& lhs, const BigRational& rhs);
+    friend inline bool operator==(const BigRational& lhs, const BigInteger& rhs);
+    friend inline std::strong_ordering operator<=>(const BigRational& lhs, const BigInteger& rhs);
+
+    friend inline void SetNumeratorR(BigRational& bigrational, BigInteger value);
+    friend inline std::pair<uint64_t, int64_t> RoundToDouble(const BigRational& bigrational, int64_t min_exponent);
+    friend inline std::pair<double, int64_t> frexp(const BigRational& bigrational);
+    friend class BigDecimal;
+    friend inline BigRational SumRationals(std::vector<BigRational>& terms, size_t threads);
+    friend inline BigRational ProductRationals(std::vector<BigRational>& terms, size_t threads);
 };
 
 inline BigRational operator+(BigRational lhs, const BigRational& rhs) { lhs += rhs; return lhs; };
@@ -1121,6 +5510,35 @@ inline BigRational operator-(BigRational lhs, const BigRational& rhs) { lhs -= r
 inline BigRational operator*(BigRational lhs, const BigRational& rhs) { lhs *= rhs; return lhs; };
 inline BigRational operator/(BigRational lhs, const BigRational& rhs) { lhs /= rhs; return lhs; };
 
+inline BigRational operator+(BigRational lhs, const BigInteger& rhs) { lhs += rhs; return lhs; };
+inline BigRational operator-(BigRational lhs, const BigInteger& rhs) { lhs -= rhs; return lhs; };
+inline BigRational operator*(BigRational lhs, const BigInteger& rhs) { lhs *= rhs; return lhs; };
+inline BigRational operator/(BigRational lhs, const BigInteger& rhs) { lhs /= rhs; return lhs; };
+inline BigRational operator+(const BigInteger& lhs, BigRational rhs) { rhs += lhs; return rhs; };
+inline BigRational operator-(const BigInteger& lhs, const BigRational& rhs) { BigRational result = -rhs; result += lhs; return result; };
+inline BigRational operator*(const BigInteger& lhs, BigRational rhs) { rhs *= lhs; return rhs; };
+inline BigRational operator/(const BigInteger& lhs, const BigRational& rhs) {
+    // k / (A/B) = (k*B) / A
+    if (GetZero(rhs.numerator)) {
+        throw std::runtime_error("Dividing by 0!");
+    }
+    BigRational result;
+    result.numerator = rhs.denominator;
+    result.denominator = rhs.numerator;
+    result.negative = rhs.negative;
+    result *= lhs;
+    return result;
+};
+
+inline BigRational operator+(BigRational lhs, int64_t rhs) { lhs += rhs; return lhs; };
+inline BigRational operator-(BigRational lhs, int64_t rhs) { lhs -= rhs; return lhs; };
+inline BigRational operator*(BigRational lhs, int64_t rhs) { lhs *= rhs; return lhs; };
+inline BigRational operator/(BigRational lhs, int64_t rhs) { lhs /= rhs; return lhs; };
+inline BigRational operator+(int64_t lhs, const BigRational& rhs) { return BigInteger(lhs) + rhs; };
+inline BigRational operator-(int64_t lhs, const BigRational& rhs) { return BigInteger(lhs) - rhs; };
+inline BigRational operator*(int64_t lhs, const BigRational& rhs) { return BigInteger(lhs) * rhs; };
+inline BigRational operator/(int64_t lhs, const BigRational& rhs) { return BigInteger(lhs) / rhs; };
+
 inline bool operator==(const BigRational& lhs, const BigRational& rhs) {
     // Ak rozne znamienka, automaticky sa cisla nerovnaju
     if (lhs.negative != rhs.negative) {
@@ -1183,6 +5601,30 @@ inline bool operator>=(const BigRational& lhs, const BigRational& rhs) {
     // Spravime negaciu, cize 'lhs' musi byt mensie ako 'rhs'; Samotna negacia musi byt znegovana, aby to platilo.
     return !(lhs < rhs);
 };
+inline bool operator==(const BigRational& lhs, const BigInteger& rhs) {
+    // Zlomok je v zakladnom tvare, cele cislo musi mat menovatel 1
+    if (!IsOne(lhs.denominator) || lhs.negative != (rhs < 0)) {
+        return false;
+    }
+    return (lhs.negative ? (-lhs.numerator == rhs) : (lhs.numerator == rhs));
+};
+inline std::strong_ordering operator<=>(const BigRational& lhs, const BigInteger& rhs) {
+    // Ak znamienka rozne (0 sa povazuje za kladne)
+    bool rhs_negative = (rhs < 0);
+    if (lhs.negative != rhs_negative) {
+        return lhs.negative ? std::strong_ordering::less : std::strong_ordering::greater;
+    }
+    // Porovnanie A s k*B; B > 0, takze sa smer nemeni
+    BigInteger scaled = IsOne(lhs.denominator) ? rhs : (lhs.denominator * rhs);
+    BigInteger value = lhs.negative ? -lhs.numerator : lhs.numerator;
+    if (value == scaled) {
+        return std::strong_ordering::equal;
+    }
+    return (value < scaled) ? std::strong_ordering::less : std::strong_ordering::greater;
+};
+inline bool operator==(const BigRational& lhs, int64_t rhs) { return (lhs == BigInteger(rhs)); };
+inline std::strong_ordering operator<=>(const BigRational& lhs, int64_t rhs) { return (lhs <=> BigInteger(rhs)); };
+
 inline std::ostream& operator<<(std::ostream& os, const BigRational& rhs) {
     // Ak je cislo zaporne, tak vypis znamienka
     if (rhs.negative) {
@@ -1205,17 +5647,10 @@ inline void SimplifyNumber(BigRational& bigrational) {
         return;
     }
 
-    BigInteger x = bigrational.numerator;
-    BigInteger y = bigrational.denominator;
-    BigInteger z;
-
+    STATS_SCOPE(BigOperation::Simplify, std::max(bigrational.numerator.numbers.size(), bigrational.denominator.numbers.size()));
     // Najdenie NSD
-    while (true) {
-        z = x % y;
-        if (GetZero(z)) { break; }
-        x = y;
-        y = z;
-    }
+    BigInteger y = gcd(bigrational.numerator, bigrational.denominator);
+
     // Delenie 1-kou nema zmysel
     if (IsOne(y)) { return; }
     
@@ -1234,11 +5669,612 @@ inline bool IsOneR(const BigRational& bigrational) {
     return (IsOne(bigrational.numerator) && IsOne(bigrational.denominator));
 }
 
+inline void SetNumeratorR(BigRational& bigrational, BigInteger value) {  // signed numerator over the current denominator, no reduction
+    if (GetZero(value)) {
+        SetToZeroR(bigrational);
+        return;
+    }
+    bigrational.negative = (value < 0);
+    bigrational.numerator = bigrational.negative ? -value : std::move(value);
+}
+
+inline std::pair<uint64_t, int64_t> RoundToDouble(const BigRational& bigrational, int64_t min_exponent) {  // |A/B| ~ significand * 2^exponent, A != 0
+    // Citatel aj menovatel iba cez najvyssie limby a exponent, bez delenia velkych cisel
+    const WideFloat numerator = ToWideFloat(bigrational.numerator);
+    const WideFloat denominator = ToWideFloat(bigrational.denominator);
+    const WideFloat wide = DivideWide(numerator, denominator);
+    if (auto rounded = RoundWide(wide, min_exponent)) {
+        return *rounded;
+    }
+    // Presny podiel s ~72 bitmi, zvysok ako sticky bit
+    const int64_t shift = 72 - (numerator.exponent - denominator.exponent);
+    BigInteger quotient;
+    BigInteger remainder;
+    if (shift >= 0) {
+        std::tie(quotient, remainder) = divmod(bigrational.numerator * pow(BigInteger(2), static_cast<uint64_t>(shift)), bigrational.denominator);
+    }
+    else {
+        std::tie(quotient, remainder) = divmod(bigrational.numerator, bigrational.denominator * pow(BigInteger(2), static_cast<uint64_t>(-shift)));
+    }
+    quotient *= 2;
+    quotient += GetZero(remainder) ? 0 : 1;
+    WideFloat exact = ToWideFloat(quotient);
+    exact.exponent -= shift + 1;
+    return *RoundWide(exact, min_exponent);
+}
+
+inline std::pair<double, int64_t> frexp(const BigRational& bigrational) {  // (mantissa, exponent), |mantissa| in <0.5, 1) rounded to 53 bits, value ~ mantissa * 2^exponent
+    if (GetZero(bigrational.numerator)) {
+        return {0.0, 0};
+    }
+    auto [significand, exponent] = RoundToDouble(bigrational, std::numeric_limits<int64_t>::min() / 2);
+    const double mantissa = std::ldexp(static_cast<double>(significand), -53);
+    return {bigrational.negative ? -mantissa : mantissa, exponent + 53};
+}
+
+// batch reductions
+inline BigRational SumRationals(std::vector<BigRational>& terms, size_t threads) {  // terms are consumed
+    BigRational result;
+    if (terms.empty()) {
+        return result;
+    }
+
+    // Listy su (citatel so znamienkom, menovatel), medzivysledky sa nekratia
+    using Fraction = std::pair<BigInteger, BigInteger>;
+    Fraction sum = BinarySplit(0, terms.size(), threads,
+        [&terms](size_t i) {
+            BigRational& term = terms[i];
+            Fraction leaf(std::move(term.numerator), std::move(term.denominator));
+            if (term.negative) { leaf.first = -leaf.first; }
+            return leaf;
+        },
+        [](Fraction left, Fraction right) {
+            // Rovnake menovatele netreba nasobit
+            if (left.second == right.second) {
+                left.first += right.first;
+                return left;
+            }
+            left.first *= right.second;
+            right.first *= left.second;
+            left.first += right.first;
+            left.second *= right.second;
+            return left;
+        });
+
+    // Jedine kratenie na konci
+    result.denominator = std::move(sum.second);
+    SetNumeratorR(result, std::move(sum.first));
+    SimplifyNumber(result);
+    return result;
+}
+
+inline BigRational ProductRationals(std::vector<BigRational>& terms, size_t threads) {  // terms are consumed
+    BigRational result;
+    std::vector<BigInteger> numerators;
+    std::vector<BigInteger> denominators;
+    numerators.reserve(terms.size());
+    denominators.reserve(terms.size());
+    bool negative = false;
+    for (BigRational& term : terms) {
+        // Nula v sucine -> vysledok 0
+        if (GetZero(term.numerator)) {
+            return result;
+        }
+        negative = (negative != term.negative);
+        numerators.push_back(std::move(term.numerator));
+        denominators.push_back(std::move(term.denominator));
+    }
+
+    result.numerator = ProductTree(numerators, 0, numerators.size(), threads);
+    result.denominator = ProductTree(denominators, 0, denominators.size(), threads);
+    result.negative = negative;
+    SimplifyNumber(result);
+    return result;
+}
+
+template <std::ranges::input_range Range>
+    requires std::same_as<std::ranges::range_value_t<Range>, BigRational>
+BigRational sum(const Range& range, size_t threads = 1) {  // sum of all elements, reduced once at the end
+    std::vector<BigRational> terms;
+    if constexpr (std::ranges::sized_range<Range>) {
+        terms.reserve(std::ranges::size(range));
+    }
+    for (const BigRational& term : range) {
+        terms.push_back(term);
+    }
+    return SumRationals(terms, threads);
+}
+
+template <std::ranges::input_range Range>
+    requires std::same_as<std::ranges::range_value_t<Range>, BigRational>
+BigRational product(const Range& range, size_t threads = 1) {  // product of all elements, reduced once at the end
+    std::vector<BigRational> terms;
+    if constexpr (std::ranges::sized_range<Range>) {
+        terms.reserve(std::ranges::size(range));
+    }
+    for (const BigRational& term : range) {
+        terms.push_back(term);
+    }
+    return ProductRationals(terms, threads);
+}
+
+// hashing and interning
+template <class Value>
+class InternTable;
+
+template <class Value>
+class Interned  // handle to a value owned by an InternTable; equal values share one copy, so == only compares pointers
+{
+public:
+    const Value& value() const { return *this->pointer; }
+    const Value& operator*() const { return *this->pointer; }
+    const Value* operator->() const { return this->pointer; }
+    operator const Value&() const { return *this->pointer; }
+
+    size_t hash() const noexcept { return std::hash<const Value*>()(this->pointer); }
+
+    friend bool operator==(const Interned& lhs, const Interned& rhs) { return lhs.pointer == rhs.pointer; }
+
+private:
+    explicit Interned(const Value* pointer)
+        : pointer(pointer)
+    {}
+
+    const Value* pointer;
+
+    friend class InternTable<Value>;
+};
+
+namespace std {
+template <>
+struct hash<BigInteger>
+{
+    size_t operator()(const BigInteger& value) const noexcept { return value.hash(); }
+};
+
+template <>
+struct hash<BigRational>
+{
+    size_t operator()(const BigRational& value) const noexcept { return value.hash(); }
+};
+
+template <class Value>
+struct hash<Interned<Value>>
+{
+    size_t operator()(const Interned<Value>& value) const noexcept { return value.hash(); }
+};
+}
+
+template <class Value>
+class InternTable  // hash-consing of BigInteger / BigRational constants; handles stay valid until clear() or destruction
+{
+public:
+    Interned<Value> intern(Value value) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        // Prvky unordered_set sa pri rehashi nepresuvaju, adresa zostava platna
+        return Interned<Value>(&*this->values.insert(std::move(value)).first);
+    }
+
+    std::optional<Interned<Value>> find(const Value& value) const {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto found = this->values.find(value);
+        if (found == this->values.end()) {
+            return std::nullopt;
+        }
+        return Interned<Value>(&*found);
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->values.size();
+    }
+
+    void clear() {  // invalidates all handles
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->values.clear();
+    }
+
+private:
+    std::unordered_set<Value> values;
+    mutable std::mutex mutex;
+};
+
+
+// fixed-scale decimals: limbs are base 10^9, so scaling by 10^k shifts k/9 whole limbs and multiplies by one small factor
+constexpr uint64_t SmallPow10(size_t exponent) {  // 10^exponent, exponent < DIGITS
+    uint64_t power = 1;
+    for (size_t i = 0; i < exponent; i++) {
+        power *= 10;
+    }
+    return power;
+}
+
+inline void MultiplyPow10(BigInteger& biginteger, uint64_t exponent) {  // biginteger *= 10^exponent
+    if (biginteger.zero || exponent == 0) {
+        return;
+    }
+    if (exponent % DIGITS != 0) {
+        biginteger.numbers = MultiplySmallLimbs(biginteger.numbers, SmallPow10(exponent % DIGITS));
+    }
+    if (exponent >= DIGITS) {
+        biginteger.numbers = ShiftLimbs(biginteger.numbers, exponent / DIGITS);
+    }
+    biginteger.hash_code = 0;
+}
+
+inline std::pair<BigInteger, DecimalFraction> DividePow10(const BigInteger& biginteger, uint64_t exponent) {  // biginteger / 10^exponent truncated toward 0 and the class of the discarded digits
+    if (biginteger.zero || exponent == 0) {
+        return {biginteger, DecimalFraction::Zero};
+    }
+    const std::vector<uint64_t>& numbers = biginteger.numbers;
+
+    // Prva zahodena cifra (rad exponent-1) a ci je pod nou nieco nenulove
+    const uint64_t position = exponent - 1;
+    uint64_t leading = 0;
+    bool rest = false;
+    if (position / DIGITS < numbers.size()) {
+        const size_t limb = position / DIGITS;
+        const uint64_t power = SmallPow10(position % DIGITS);
+        leading = (numbers[limb] / power) % 10;
+        rest = (numbers[limb] % power) != 0;
+        for (size_t i = 0; i < limb && !rest; i++) {
+            rest = (numbers[i] != 0);
+        }
+    }
+    else {
+        rest = true;
+    }
+    DecimalFraction fraction = DecimalFraction::Zero;
+    if (leading > 5 || (leading == 5 && rest)) {
+        fraction = DecimalFraction::AboveHalf;
+    }
+    else if (leading == 5) {
+        fraction = DecimalFraction::Half;
+    }
+    else if (leading != 0 || rest) {
+        fraction = DecimalFraction::BelowHalf;
+    }
+
+    // Cele limby sa iba zahodia, zvysne cifry vydeli jedno male delenie
+    BigInteger quotient;
+    if (exponent / DIGITS < numbers.size()) {
+        quotient.numbers.assign(numbers.begin() + (exponent / DIGITS), numbers.end());
+        if (exponent % DIGITS != 0) {
+            DivideSmallLimbs(quotient.numbers, SmallPow10(exponent % DIGITS));
+        }
+        quotient.zero = (quotient.numbers.size() == 1 && quotient.numbers[0] == 0);
+        quotient.negative = biginteger.negative && !quotient.zero;
+    }
+    return {std::move(quotient), fraction};
+}
+
+inline void RoundQuotient(BigInteger& quotient, bool negative, DecimalFraction fraction, RoundingMode mode) {  // quotient is truncated toward 0; negative = sign of the exact result
+    if (fraction == DecimalFraction::Zero) {
+        return;
+    }
+    bool away = false;
+    switch (mode) {
+        case RoundingMode::Down: away = false; break;
+        case RoundingMode::Up: away = true; break;
+        case RoundingMode::Floor: away = negative; break;
+        case RoundingMode::Ceiling: away = !negative; break;
+        case RoundingMode::HalfUp: away = (fraction != DecimalFraction::BelowHalf); break;
+        case RoundingMode::HalfDown: away = (fraction == DecimalFraction::AboveHalf); break;
+        case RoundingMode::HalfEven: away = (fraction == DecimalFraction::AboveHalf) || (fraction == DecimalFraction::Half && RemainderSmall(quotient, 2) == 1); break;
+    }
+    if (away) {
+        quotient += negative ? -1 : 1;
+    }
+}
+
+class BigDecimal  // coefficient * 10^-scale; exact + - * only align scales, no GCD anywhere
+{
+public:
+    // constructors
+    BigDecimal()
+        : coefficient(0)
+        , fraction_digits(0)
+    {}
+
+    BigDecimal(int64_t value)
+        : coefficient(value)
+        , fraction_digits(0)
+    {}
+
+    BigDecimal(BigInteger unscaled, int32_t scale)
+        : coefficient(std::move(unscaled))
+        , fraction_digits(scale)
+    {}
+
+    explicit BigDecimal(const std::string& str)
+        : coefficient(0)
+        , fraction_digits(0)
+    {
+        // Zachytenie prazdneho stringu
+        if (str.empty()) {
+            throw std::runtime_error("Empty BigDecimal!");
+        }
+        const size_t position = (str[0] == '+' || str[0] == '-') ? 1 : 0;
+        size_t point = std::string::npos;
+        size_t digits = 0;
+        // Overenie, ze v stringu su iba cifry a najviac jedna bodka
+        for (size_t i = position; i < str.size(); i++) {
+            if (str[i] == '.' && point == std::string::npos) {
+                point = i;
+            }
+            else if (str[i] >= '0' && str[i] <= '9') {
+                digits++;
+            }
+            else {
+                throw std::runtime_error("Only digit(s) and one '.' allowed in BigDecimal!");
+            }
+        }
+        if (digits == 0) {
+            throw std::runtime_error("No digit(s) in BigDecimal!");
+        }
+        if (point == std::string::npos) {
+            this->coefficient = BigInteger(str);
+            return;
+        }
+        if (str.size() - point - 1 > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+            throw std::runtime_error("BigDecimal scale out of range!");
+        }
+        // Bez bodky je to cele cislo 'coefficient', pocet cifier za bodkou je 'scale'
+        this->coefficient = BigInteger(str.substr(0, point) + str.substr(point + 1));
+        this->fraction_digits = static_cast<int32_t>(str.size() - point - 1);
+    };
+
+    BigDecimal(const BigRational& value, int32_t scale, RoundingMode mode = RoundingMode::HalfEven)
+        : coefficient(0)
+        , fraction_digits(scale)
+    {
+        BigDecimal numerator(value.negative ? -value.numerator : value.numerator, 0);
+        *this = numerator.divide(BigDecimal(value.denominator, 0), scale, mode);
+    };
+
+    // access
+    const BigInteger& unscaled_value() const { return this->coefficient; };
+    int32_t scale() const { return this->fraction_digits; };
+
+    BigRational to_rational() const {
+        BigRational result;
+        result += this->coefficient;
+        BigInteger power(1);
+        MultiplyPow10(power, static_cast<uint64_t>(std::abs(static_cast<int64_t>(this->fraction_digits))));
+        // Jedine kratenie je tu, pri prevode
+        if (this->fraction_digits > 0) {
+            result /= power;
+        }
+        else {
+            result *= power;
+        }
+        return result;
+    };
+
+    // unary operators
+    const BigDecimal& operator+() const {
+        return *this;
+    };
+
+    BigDecimal operator-() const {
+        return BigDecimal(-this->coefficient, this->fraction_digits);
+    };
+
+    // binary arithmetics operators
+    BigDecimal& operator+=(const BigDecimal& rhs) {
+        // Zarovnanie na vacsi pocet desatinnych miest
+        if (rhs.fraction_digits > this->fraction_digits) {
+            this->align(rhs.fraction_digits);
+        }
+        if (rhs.fraction_digits < this->fraction_digits) {
+            this->coefficient += rhs.aligned(this->fraction_digits);
+        }
+        else {
+            this->coefficient += rhs.coefficient;
+        }
+        return *this;
+    };
+
+    BigDecimal& operator-=(const BigDecimal& rhs) {
+        if (rhs.fraction_digits > this->fraction_digits) {
+            this->align(rhs.fraction_digits);
+        }
+        if (rhs.fraction_digits < this->fraction_digits) {
+            this->coefficient -= rhs.aligned(this->fraction_digits);
+        }
+        else {
+            this->coefficient -= rhs.coefficient;
+        }
+        return *this;
+    };
+
+    BigDecimal& operator*=(const BigDecimal& rhs) {
+        this->fraction_digits = CheckedScale(static_cast<int64_t>(this->fraction_digits) + rhs.fraction_digits);
+        this->coefficient *= rhs.coefficient;
+        return *this;
+    };
+
+    BigDecimal divide(const BigDecimal& rhs, int32_t scale, RoundingMode mode = RoundingMode::HalfEven) const {  // this / rhs with 'scale' fraction digits
+        // Ak A/0
+        if (GetZero(rhs.coefficient)) {
+            throw std::runtime_error("Dividing by 0!");
+        }
+        // (a * 10^-sa) / (b * 10^-sb) = (a * 10^(scale - sa + sb) / b) * 10^-scale
+        const int64_t shift = static_cast<int64_t>(scale) - this->fraction_digits + rhs.fraction_digits;
+        BigInteger numerator = this->coefficient;
+        BigInteger denominator = rhs.coefficient;
+        if (shift >= 0) {
+            MultiplyPow10(numerator, static_cast<uint64_t>(shift));
+        }
+        else {
+            MultiplyPow10(denominator, static_cast<uint64_t>(-shift));
+        }
+        auto [quotient, remainder] = divmod(numerator, denominator);
+
+        // Zvysok porovnany s polovicou delitela: 2|r| ? |b|
+        DecimalFraction fraction = DecimalFraction::Zero;
+        if (!GetZero(remainder)) {
+            BigInteger twice = remainder + remainder;
+            if (GetNegative(twice)) { twice = -twice; }
+            if (GetNegative(denominator)) { denominator = -denominator; }
+            if (twice == denominator) {
+                fraction = DecimalFraction::Half;
+            }
+            else {
+                fraction = (twice < denominator) ? DecimalFraction::BelowHalf : DecimalFraction::AboveHalf;
+            }
+        }
+        RoundQuotient(quotient, GetNegative(this->coefficient) != GetNegative(rhs.coefficient), fraction, mode);
+        return BigDecimal(std::move(quotient), scale);
+    };
+
+    BigDecimal rescale(int32_t scale, RoundingMode mode = RoundingMode::HalfEven) const {  // same value with 'scale' fraction digits
+        if (scale >= this->fraction_digits) {
+            return BigDecimal(this->aligned(scale), scale);
+        }
+        auto [quotient, fraction] = DividePow10(this->coefficient, static_cast<uint64_t>(static_cast<int64_t>(this->fraction_digits) - scale));
+        RoundQuotient(quotient, GetNegative(this->coefficient), fraction, mode);
+        return BigDecimal(std::move(quotient), scale);
+    };
+
+private:
+    BigInteger coefficient;
+    int32_t fraction_digits;
+
+    static int32_t CheckedScale(int64_t scale) {
+        if (scale > std::numeric_limits<int32_t>::max() || scale < std::numeric_limits<int32_t>::min()) {
+            throw std::runtime_error("BigDecimal scale out of range!");
+        }
+        return static_cast<int32_t>(scale);
+    }
+
+    void align(int32_t scale) {  // scale >= fraction_digits
+        MultiplyPow10(this->coefficient, static_cast<uint64_t>(static_cast<int64_t>(scale) - this->fraction_digits));
+        this->fraction_digits = scale;
+    }
+
+    BigInteger aligned(int32_t scale) const {  // coefficient for 'scale' >= fraction_digits
+        BigInteger result = this->coefficient;
+        MultiplyPow10(result, static_cast<uint64_t>(static_cast<int64_t>(scale) - this->fraction_digits));
+        return result;
+    }
+
+    friend inline bool operator==(const BigDecimal& lhs, const BigDecimal& rhs);
+    friend inline std::strong_ordering operator<=>(const BigDecimal& lhs, const BigDecimal& rhs);
+    friend inline std::ostream& operator<<(std::ostream& os, const BigDecimal& rhs);
+};
+
+inline BigDecimal operator+(BigDecimal lhs, const BigDecimal& rhs) { lhs += rhs; return lhs; };
+inline BigDecimal operator-(BigDecimal lhs, const BigDecimal& rhs) { lhs -= rhs; return lhs; };
+inline BigDecimal operator*(BigDecimal lhs, const BigDecimal& rhs) { lhs *= rhs; return lhs; };
+
+inline bool operator==(const BigDecimal& lhs, const BigDecimal& rhs) {
+    // Porovnava sa hodnota, 1.50 == 1.5
+    if (lhs.fraction_digits == rhs.fraction_digits) {
+        return (lhs.coefficient == rhs.coefficient);
+    }
+    if (lhs.fraction_digits < rhs.fraction_digits) {
+        return (lhs.aligned(rhs.fraction_digits) == rhs.coefficient);
+    }
+    return (lhs.coefficient == rhs.aligned(lhs.fraction_digits));
+};
+inline std::strong_ordering operator<=>(const BigDecimal& lhs, const BigDecimal& rhs) {
+    // Ak znamienka rozne, netreba zarovnavat
+    const int lhs_sign = GetZero(lhs.coefficient) ? 0 : (GetNegative(lhs.coefficient) ? -1 : 1);
+    const int rhs_sign = GetZero(rhs.coefficient) ? 0 : (GetNegative(rhs.coefficient) ? -1 : 1);
+    if (lhs_sign != rhs_sign) {
+        return lhs_sign <=> rhs_sign;
+    }
+    const int32_t scale = std::max(lhs.fraction_digits, rhs.fraction_digits);
+    const BigInteger left = lhs.aligned(scale);
+    const BigInteger right = rhs.aligned(scale);
+    if (left == right) {
+        return std::strong_ordering::equal;
+    }
+    return (left < right) ? std::strong_ordering::less : std::strong_ordering::greater;
+};
+inline std::ostream& operator<<(std::ostream& os, const BigDecimal& rhs) {
+    std::ostringstream digits;
+    digits << (GetNegative(rhs.coefficient) ? -rhs.coefficient : rhs.coefficient);
+    std::string text = digits.str();
+
+    // Zaporna scale: nuly na konci; Kladna: bodka, pripadne nuly za '0.'
+    if (rhs.fraction_digits <= 0) {
+        if (!GetZero(rhs.coefficient)) {
+            text.append(static_cast<size_t>(-static_cast<int64_t>(rhs.fraction_digits)), '0');
+        }
+    }
+    else {
+        const size_t scale = static_cast<size_t>(rhs.fraction_digits);
+        if (text.size() <= scale) {
+            text.insert(0, (scale - text.size()) + 1, '0');
+        }
+        text.insert(text.size() - scale, 1, '.');
+    }
+    if (GetNegative(rhs.coefficient)) {
+        os << '-';
+    }
+    os << text;
+    return os;
+};
+
+
+inline void BigRational::write_decimal(std::ostream& os, size_t digits, RoundingMode mode) const {
+    if (digits > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        throw std::runtime_error("BigDecimal scale out of range!");
+    }
+    os << BigDecimal(*this, static_cast<int32_t>(digits), mode);
+}
+
+inline std::string BigRational::to_decimal_string(size_t digits, RoundingMode mode) const {
+    std::ostringstream os;
+    this->write_decimal(os, digits, mode);
+    return os.str();
+}
+
+#if SUPPORT_MORE_OPS == 1
+inline BigDecimal BigRational::sqrt(size_t digits) const {
+    // Ak zaporne cislo
+    if (this->negative) {
+        throw std::runtime_error("No SQRT of negative BigRational");
+    }
+    if (digits > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        throw std::runtime_error("BigDecimal scale out of range!");
+    }
+    // floor(sqrt(A/B) * 10^d) = isqrt(floor(A * 10^(2d) / B))
+    BigInteger scaled = this->numerator;
+    MultiplyPow10(scaled, 2 * static_cast<uint64_t>(digits));
+    if (!IsOne(this->denominator)) {
+        scaled /= this->denominator;
+    }
+    return BigDecimal(scaled.isqrt(), static_cast<int32_t>(digits));
+}
+#endif
+
 
 #if SUPPORT_IFSTREAM == 1
 // this should behave exactly the same as reading int with respect to 
 // whitespace, consumed characters etc...
-inline std::istream& operator>>(std::istream& lhs, BigRational& rhs); // bonus
+inline std::istream& operator>>(std::istream& lhs, BigRational& rhs) { // bonus
+    // "a" alebo "a/b", cisla v zaklade podla std::dec / std::hex / std::oct
+    BigInteger numerator;
+    BigInteger denominator(1);
+    if (!(lhs >> numerator)) {
+        return lhs;
+    }
+    if (lhs.peek() == '/') {
+        lhs.get();
+        if (!(lhs >> denominator)) {
+            return lhs;
+        }
+    }
+    if (GetZero(denominator)) {
+        lhs.setstate(std::ios_base::failbit);
+        return lhs;
+    }
+    rhs = BigRational(numerator.to_string(), denominator.to_string());
+    return lhs;
+}
 #endif
 
 #if SUPPORT_EVAL == 1
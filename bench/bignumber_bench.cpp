@@ -0,0 +1,287 @@
+// Benchmark of every BigNumber.h operation across operand sizes.
+//
+// usage: bignumber_bench [--format csv|json] [--max-digits N] [--min-time MS] [--ops op1,op2,...]
+//
+// Output is machine-readable (one row per operation and size), so results of
+// two commits can be diffed directly. Without --max-digits every operation
+// stops at its own default limit; --max-digits N replaces those limits for
+// all operations (raising or lowering them).
+
+#include "BigNumber.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct BenchResult
+{
+    std::string operation;
+    size_t digits;
+    size_t limbs;
+    uint64_t iterations;
+    double ns_per_op;
+};
+
+struct BenchOptions
+{
+    std::string format = "csv";
+    std::optional<size_t> max_digits;  // none: DEFAULT_LIMITS per operation
+    double min_time_ms = 100;
+    std::vector<std::string> ops;
+};
+
+// Velkosti operandov: od 1 limbu po 10^6 cifier
+static const std::vector<size_t> SIZES = {9, 30, 100, 300, 1'000, 3'000, 10'000, 30'000, 100'000, 300'000, 1'000'000};
+
+// Predvolena horna hranica cifier pre kazdu operaciu, aby beh bez volieb skoncil rychlo; --max-digits ju nahradi
+static const std::map<std::string, size_t> DEFAULT_LIMITS = {
+    {"construct", 1'000'000},
+    {"print", 1'000'000},
+    {"serialize", 1'000'000},
+    {"deserialize", 1'000'000},
+    {"add", 1'000'000},
+    {"sub", 1'000'000},
+    {"mul", 100'000},
+    {"div", 100'000},
+    {"mod", 100'000},
+    {"isqrt", 100'000},
+    {"pow_mod", 1'000},
+    {"is_prime", 300},
+    {"rational_add", 1'000},
+    {"rational_mul", 1'000},
+    {"rational_cmp", 10'000},
+};
+
+static std::string RandomDigits(size_t digits, std::mt19937_64& rng) {
+    std::uniform_int_distribution<int> digit(0, 9);
+    std::string text(digits, '0');
+    for (char& c : text) {
+        c = static_cast<char>('0' + digit(rng));
+    }
+    // Prva cifra nenulova, aby mal operand presne 'digits' cifier
+    text[0] = static_cast<char>('1' + (digit(rng) % 9));
+    return text;
+}
+
+static BenchResult Measure(const std::string& operation, size_t digits, double min_time_ms, const std::function<void()>& body) {
+    using clock = std::chrono::steady_clock;
+    uint64_t iterations = 0;
+    uint64_t batch = 1;
+    auto start = clock::now();
+    double elapsed_ns = 0;
+
+    // Opakovanie, kym meranie netrva aspon min_time_ms
+    while (true) {
+        for (uint64_t i = 0; i < batch; i++) {
+            body();
+        }
+        iterations += batch;
+        elapsed_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        if (elapsed_ns >= min_time_ms * 1e6) { break; }
+        batch *= 2;
+    }
+    return {operation, digits, (digits + DIGITS - 1) / DIGITS, iterations, elapsed_ns / iterations};
+}
+
+static std::vector<BenchResult> RunAll(const BenchOptions& options) {
+    std::vector<BenchResult> results;
+    std::mt19937_64 rng(20240101);
+    volatile size_t sink = 0;
+
+    auto enabled = [&](const std::string& operation, size_t digits) {
+        if (digits > options.max_digits.value_or(DEFAULT_LIMITS.at(operation))) {
+            return false;
+        }
+        if (options.ops.empty()) {
+            return true;
+        }
+        return std::find(options.ops.begin(), options.ops.end(), operation) != options.ops.end();
+    };
+
+    for (size_t digits : SIZES) {
+        const std::string text_a = RandomDigits(digits, rng);
+        const std::string text_b = RandomDigits(digits, rng);
+        const std::string text_wide = RandomDigits(2 * digits, rng);
+        const BigInteger a(text_a);
+        const BigInteger b(text_b);
+        const BigInteger wide(text_wide);
+
+        if (enabled("construct", digits)) {
+            results.push_back(Measure("construct", digits, options.min_time_ms, [&] {
+                BigInteger value(text_a);
+                sink = sink + GetZero(value);
+            }));
+        }
+        if (enabled("print", digits)) {
+            results.push_back(Measure("print", digits, options.min_time_ms, [&] {
+                std::ostringstream oss;
+                oss << a;
+                sink = sink + oss.str().size();
+            }));
+        }
+        if (enabled("serialize", digits)) {
+            results.push_back(Measure("serialize", digits, options.min_time_ms, [&] {
+                std::vector<std::byte> buffer = a.serialize();
+                sink = sink + buffer.size();
+            }));
+        }
+        if (enabled("deserialize", digits)) {
+            const std::vector<std::byte> buffer = a.serialize();
+            results.push_back(Measure("deserialize", digits, options.min_time_ms, [&] {
+                BigInteger value = BigInteger::deserialize(buffer);
+                sink = sink + GetZero(value);
+            }));
+        }
+        if (enabled("add", digits)) {
+            results.push_back(Measure("add", digits, options.min_time_ms, [&] {
+                BigInteger value = a + b;
+                sink = sink + GetZero(value);
+            }));
+        }
+        if (enabled("sub", digits)) {
+            results.push_back(Measure("sub", digits, options.min_time_ms, [&] {
+                BigInteger value = a - b;
+                sink = sink + GetZero(value);
+            }));
+        }
+        if (enabled("mul", digits)) {
+            results.push_back(Measure("mul", digits, options.min_time_ms, [&] {
+                BigInteger value = a * b;
+                sink = sink + GetZero(value);
+            }));
+        }
+        // Delenie: delenec ma 2x viac cifier ako delitel
+        if (enabled("div", digits)) {
+            results.push_back(Measure("div", digits, options.min_time_ms, [&] {
+                BigInteger value = wide / b;
+                sink = sink + GetZero(value);
+            }));
+        }
+        if (enabled("mod", digits)) {
+            results.push_back(Measure("mod", digits, options.min_time_ms, [&] {
+                BigInteger value = wide % b;
+                sink = sink + GetZero(value);
+            }));
+        }
+        if (enabled("isqrt", digits)) {
+            results.push_back(Measure("isqrt", digits, options.min_time_ms, [&] {
+                BigInteger value = a.isqrt();
+                sink = sink + GetZero(value);
+            }));
+        }
+        // Modul 10k+1 (Montgomery pod BIGNUMBER_MONTGOMERY_THRESHOLD), exponent ma rovnaku dlzku
+        if (enabled("pow_mod", digits)) {
+            const BigInteger modulus = (b * BigInteger(10)) + BigInteger(1);
+            results.push_back(Measure("pow_mod", digits, options.min_time_ms, [&] {
+                BigInteger value = pow_mod(a, b, modulus);
+                sink = sink + GetZero(value);
+            }));
+        }
+        // Prvocislo je najhorsi pripad (ziadne skorsie zamietnutie)
+        if (enabled("is_prime", digits)) {
+            const BigInteger prime = next_prime(a);
+            results.push_back(Measure("is_prime", digits, options.min_time_ms, [&] {
+                sink = sink + prime.is_prime(1);
+            }));
+        }
+        if (enabled("rational_add", digits) || enabled("rational_mul", digits) || enabled("rational_cmp", digits)) {
+            const BigRational x(text_a, text_b);
+            const BigRational y(text_b, text_wide.substr(0, digits));
+            if (enabled("rational_add", digits)) {
+                results.push_back(Measure("rational_add", digits, options.min_time_ms, [&] {
+                    BigRational value = x + y;
+                    sink = sink + (value < x);
+                }));
+            }
+            if (enabled("rational_mul", digits)) {
+                results.push_back(Measure("rational_mul", digits, options.min_time_ms, [&] {
+                    BigRational value = x * y;
+                    sink = sink + (value < x);
+                }));
+            }
+            if (enabled("rational_cmp", digits)) {
+                results.push_back(Measure("rational_cmp", digits, options.min_time_ms, [&] {
+                    sink = sink + (x < y);
+                }));
+            }
+        }
+    }
+    return results;
+}
+
+static void PrintCsv(const std::vector<BenchResult>& results) {
+    std::cout << "operation,digits,limbs,iterations,ns_per_op\n";
+    for (const BenchResult& result : results) {
+        std::cout << result.operation << ',' << result.digits << ',' << result.limbs << ','
+                  << result.iterations << ',' << std::fixed << std::setprecision(1) << result.ns_per_op << '\n';
+    }
+}
+
+static void PrintJson(const std::vector<BenchResult>& results) {
+    std::cout << "[\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& result = results[i];
+        std::cout << "  {\"operation\": \"" << result.operation << "\", \"digits\": " << result.digits
+                  << ", \"limbs\": " << result.limbs << ", \"iterations\": " << result.iterations
+                  << ", \"ns_per_op\": " << std::fixed << std::setprecision(1) << result.ns_per_op << '}'
+                  << ((i + 1 < results.size()) ? ",\n" : "\n");
+    }
+    std::cout << "]\n";
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        // Kazda volba ma hodnotu
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << '\n';
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--format") {
+            options.format = value;
+        }
+        else if (arg == "--max-digits") {
+            options.max_digits = std::stoull(value);
+        }
+        else if (arg == "--min-time") {
+            options.min_time_ms = std::stod(value);
+        }
+        else if (arg == "--ops") {
+            std::stringstream list(value);
+            std::string op;
+            while (std::getline(list, op, ',')) {
+                if (DEFAULT_LIMITS.count(op) == 0) {
+                    std::cerr << "Unknown operation: " << op << '\n';
+                    return 1;
+                }
+                options.ops.push_back(op);
+            }
+        }
+        else {
+            std::cerr << "Unknown option: " << arg << '\n';
+            return 1;
+        }
+    }
+    if (options.format != "csv" && options.format != "json") {
+        std::cerr << "Format must be csv or json\n";
+        return 1;
+    }
+
+    std::vector<BenchResult> results = RunAll(options);
+    if (options.format == "json") {
+        PrintJson(results);
+    }
+    else {
+        PrintCsv(results);
+    }
+    return 0;
+}
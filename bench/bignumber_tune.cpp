@@ -0,0 +1,134 @@
+// Measures kernel crossover points on this host and writes BigNumberTuning.h.
+//
+// usage: bignumber_tune [output path, default BigNumberTuning.h]
+//
+// BigNumber.h picks the generated header up via __has_include and falls back
+// to its built-in defaults when it is absent.
+
+#include "BigNumber.h"
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static double TimeNs(const std::function<void()>& body) {
+    using clock = std::chrono::steady_clock;
+    double best = std::numeric_limits<double>::max();
+    // Najlepsi z 3 pokusov; Kazdy pokus trva aspon 20 ms
+    for (int attempt = 0; attempt < 3; attempt++) {
+        uint64_t iterations = 0;
+        auto start = clock::now();
+        double elapsed = 0;
+        while (elapsed < 20e6) {
+            body();
+            iterations++;
+            elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        }
+        best = std::min(best, elapsed / iterations);
+    }
+    return best;
+}
+
+static std::vector<uint64_t> RandomLimbs(size_t size, std::mt19937_64& rng) {
+    std::uniform_int_distribution<uint64_t> limb(0, MODULO - 1);
+    std::vector<uint64_t> limbs(size);
+    for (uint64_t& value : limbs) {
+        value = limb(rng);
+    }
+    // Najvyssi limb nenulovy
+    limbs.back() = 1 + (limbs.back() % (MODULO - 1));
+    return limbs;
+}
+
+// Prva velkost, od ktorej vyhra rekurzivny algoritmus dvakrat po sebe
+static size_t Crossover(const std::string& name, const std::vector<size_t>& sizes, const std::function<double(size_t)>& base, const std::function<double(size_t)>& recursive) {
+    size_t wins = 0;
+    for (size_t i = 0; i < sizes.size(); i++) {
+        double base_ns = base(sizes[i]);
+        double recursive_ns = recursive(sizes[i]);
+        std::cerr << name << ": " << sizes[i] << " limbs, base " << base_ns << " ns, recursive " << recursive_ns << " ns\n";
+        wins = (recursive_ns < base_ns) ? (wins + 1) : 0;
+        if (wins == 2) {
+            return sizes[i - 1];
+        }
+    }
+    return sizes.back();
+}
+
+int main(int argc, char** argv) {
+    const std::string path = (argc > 1) ? argv[1] : "BigNumberTuning.h";
+    std::mt19937_64 rng(12345);
+    volatile size_t sink = 0;
+
+    // Nasobenie: skolske vs. jedna uroven Karatsuby (polovice uz skolsky)
+    const std::vector<size_t> mul_sizes = {8, 12, 16, 20, 24, 32, 40, 48, 56, 64, 80, 96, 128, 160, 192, 256};
+    size_t karatsuba = Crossover("mul", mul_sizes,
+        [&](size_t n) {
+            std::vector<uint64_t> a = RandomLimbs(n, rng);
+            std::vector<uint64_t> b = RandomLimbs(n, rng);
+            return TimeNs([&] { sink = sink + MultiplyLimbs(a, b, n + 1).size(); });
+        },
+        [&](size_t n) {
+            std::vector<uint64_t> a = RandomLimbs(n, rng);
+            std::vector<uint64_t> b = RandomLimbs(n, rng);
+            return TimeNs([&] { sink = sink + MultiplyLimbs(a, b, n).size(); });
+        });
+
+    // Delenie 2n/n: Knuth vs. jedna uroven Burnikel-Ziegler (polovice uz Knuth)
+    const std::vector<size_t> div_sizes = {16, 24, 32, 40, 48, 64, 80, 96, 128, 160, 192, 256, 384, 512};
+    size_t burnikel_ziegler = Crossover("div", div_sizes,
+        [&](size_t n) {
+            std::vector<uint64_t> a = RandomLimbs(2 * n, rng);
+            std::vector<uint64_t> b = RandomLimbs(n, rng);
+            std::vector<uint64_t> quotient;
+            std::vector<uint64_t> remainder;
+            return TimeNs([&] { DivideKnuth(a, b, quotient, remainder); sink = sink + quotient.size(); });
+        },
+        [&](size_t n) {
+            std::vector<uint64_t> a = RandomLimbs(2 * n, rng);
+            std::vector<uint64_t> b = RandomLimbs(n, rng);
+            std::vector<uint64_t> quotient;
+            std::vector<uint64_t> remainder;
+            return TimeNs([&] { DivideBurnikelZiegler(a, b, quotient, remainder, n); sink = sink + quotient.size(); });
+        });
+
+    // Modularne umocnenie: Montgomery vs. nasobenie + delenie (256-bitovy exponent)
+    const std::vector<size_t> pow_sizes = {16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 256, 320};
+    auto modular = [&](size_t n, bool montgomery) {
+        // n limbov ~ 29.9 * n bitov; Modul 10k+1 je nesudelitelny s 10
+        const BigInteger modulus = (random_bits((299 * n) / 10, rng) * BigInteger(10)) + BigInteger(1);
+        const BigInteger base = random_bits((299 * n) / 10, rng);
+        const std::vector<uint32_t> exponent = ToBinaryWords(random_bits(256, rng));
+        if (montgomery) {
+            MontgomeryContext context(modulus);
+            const MontgomeryContext::Residue residue = context.to_montgomery(base);
+            return TimeNs([&] { sink = sink + context.pow(residue, exponent).size(); });
+        }
+        return TimeNs([&] {
+            BigInteger result = SlidingWindowPow(base % modulus, BigInteger(1), exponent,
+                [&](BigInteger& accumulator, const BigInteger& factor) { accumulator *= factor; accumulator %= modulus; },
+                [&](BigInteger& accumulator) { accumulator *= accumulator; accumulator %= modulus; });
+            sink = sink + GetZero(result);
+        });
+    };
+    size_t montgomery = Crossover("pow_mod", pow_sizes,
+        [&](size_t n) { return modular(n, true); },
+        [&](size_t n) { return modular(n, false); });
+
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Cannot write " << path << '\n';
+        return 1;
+    }
+    out << "// Generated by bignumber_tune for this host; rerun it instead of editing by hand.\n"
+        << "#pragma once\n\n"
+        << "#define BIGNUMBER_KARATSUBA_THRESHOLD " << karatsuba << '\n'
+        << "#define BIGNUMBER_BURNIKEL_ZIEGLER_THRESHOLD " << burnikel_ziegler << '\n'
+        << "#define BIGNUMBER_MONTGOMERY_THRESHOLD " << montgomery << '\n';
+
+    std::cout << "karatsuba=" << karatsuba << " burnikel_ziegler=" << burnikel_ziegler << " montgomery=" << montgomery << " -> " << path << '\n';
+    return 0;
+}